@@ -4,14 +4,23 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+// handles of the uniforms set every draw
+static constexpr UniformHandle ProjectionUniform = "projection"_uniform;
+
 
 void Batcher::Init()
 {
-	cpuBuffer = new BatchVertex[maxVerticesPerBatch];
 	numVertices = 0;
 	numTriangles = 0;
 
-	gpuBuffer = new Buffer(maxVerticesPerBatch * sizeof(BatchVertex), cpuBuffer, true);
+	size_t regionSize = maxVerticesPerBatch * sizeof(BatchVertex);
+	gpuBuffer = new Buffer(regionSize * BatchRegions, nullptr,
+		BufferStorage::MapWrite | BufferStorage::MapPersistent | BufferStorage::MapCoherent, MemoryCategory::Vertex);
+	mappedVertices = (BatchVertex*)gpuBuffer->MapRange(0, regionSize * BatchRegions,
+		BufferMap::Write | BufferMap::Persistent | BufferMap::Coherent | BufferMap::Unsynchronized);
+
+	region = 0;
+	cpuBuffer = mappedVertices;
 
 	std::string v_shader_source = R"(
 		#version 460
@@ -76,15 +85,32 @@ void Batcher::Start()
 
 void Batcher::Draw()
 {
-	size_t size = numVertices * sizeof(BatchVertex);
-	gpuBuffer->SubData(size, 0, cpuBuffer);
+	if (numVertices == 0)
+		return;
+
 	vertexInput->Bind();
 	shaderProgram->Bind();
 
 	glm::mat4 projection = glm::ortho(0.0f, 1920.0f, 1080.0f, 0.0f);
-	shaderProgram->UniformMat4("projection", glm::value_ptr(projection));
+	shaderProgram->UniformMat4(ProjectionUniform, glm::value_ptr(projection));
+
+	// the vertices were written straight into the mapped region, there is nothing to upload
+	glDrawArrays(GL_TRIANGLES, (int)(region * maxVerticesPerBatch), (int)numVertices);
+
+	regionFences[region] = new Fence();
+	region = (region + 1) % BatchRegions;
+
+	// only blocks if the gpu is still reading the region from BatchRegions draws ago
+	if (regionFences[region])
+	{
+		regionFences[region]->Wait();
+		delete regionFences[region];
+		regionFences[region] = nullptr;
+	}
 
-	glDrawArrays(GL_TRIANGLES, 0, (int)numVertices);
+	cpuBuffer = mappedVertices + region * maxVerticesPerBatch;
+	numVertices = 0;
+	numTriangles = 0;
 }
 
 void Batcher::End()
@@ -92,35 +118,41 @@ void Batcher::End()
 	Draw();
 }
 
-void Batcher::DrawTriangle(
-	const glm::vec4& p1, const glm::vec4& p2, const glm::vec4& p3,
-	const glm::vec4& c1, const glm::vec4& c2, const glm::vec4& c3,
-	const glm::vec2& uv1, const glm::vec2& uv2, const glm::vec2& uv3,
-	uint64_t textureHandle
-)
+BatchVertex* Batcher::AllocateVertices(size_t count)
 {
-	if (numVertices >= maxVerticesPerBatch)
+	if (count > maxVerticesPerBatch)
+		return nullptr;
+
+	if (numVertices + count > maxVerticesPerBatch)
 	{
 		End();
 		Start();
 	}
 
-	const glm::vec4 positions[3] = { p1, p2, p3 };
-	const glm::vec4 colors[3] = { c1, c2, c3 };
-	const glm::vec2 uvs[3] = { uv1, uv2, uv3 };
-	const auto t = glm::vec2((float)(textureHandle >> 32), (float)(textureHandle & 0xFFFFFFFF));
+	auto vertices = cpuBuffer + numVertices;
+	numVertices += count;
+	numTriangles += count / 3;
+	return vertices;
+}
 
-	for (int i = 0; i < 3; i++)
-	{
-		cpuBuffer[numVertices].position = positions[i];
-		cpuBuffer[numVertices].color = colors[i];
-		cpuBuffer[numVertices].uv = uvs[i];
-		cpuBuffer[numVertices].texture_handle = t;
+BatchVertex* Batcher::AllocateQuads(size_t count)
+{
+	return AllocateVertices(count * 6);
+}
 
-		numVertices++;
-	}
+void Batcher::DrawTriangle(
+	const glm::vec4& p1, const glm::vec4& p2, const glm::vec4& p3,
+	const glm::vec4& c1, const glm::vec4& c2, const glm::vec4& c3,
+	const glm::vec2& uv1, const glm::vec2& uv2, const glm::vec2& uv3,
+	uint64_t textureHandle
+)
+{
+	auto vertices = AllocateVertices(3);
+	const auto t = PackTextureHandle(textureHandle);
 
-	numTriangles++;
+	vertices[0] = { p1, c1, uv1, t };
+	vertices[1] = { p2, c2, uv2, t };
+	vertices[2] = { p3, c3, uv3, t };
 }
 
 void Batcher::DrawQuadEx(
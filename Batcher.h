@@ -1,6 +1,7 @@
 #pragma once
 #include "Shader.h"
 #include "VertexInput.h"
+#include "Fence.h"
 
 #include <glm/glm.hpp>
 
@@ -50,7 +51,8 @@ public:
 
 	~Batcher()
 	{
-		delete cpuBuffer;
+		for (auto fence : regionFences)
+			delete fence;
 		delete gpuBuffer;
 		delete vertexInput;
 		delete shaderProgram;
@@ -78,12 +80,45 @@ public:
 	void DrawQuad(const Quad& quad, const glm::vec2& origin = OriginTopLeft);
 	void DrawQuad(const glm::vec2& pos, const glm::vec2& size, const glm::vec4& color, const glm::vec2& origin = OriginTopLeft);
 
+	/**
+	* reserves vertices in the current batch so they can be written in place without an intermediate copy.
+	* if the batch does not have room for count vertices it is flushed first, so the returned pointer is only
+	* valid until the next Allocate* / Draw* / Start / End call. write every attribute of every vertex front
+	* to back and never read from it, the memory is upload memory
+	* @param count number of vertices to reserve (a multiple of 3, vertices are drawn as triangles)
+	* @returns pointer to the first vertex or null if count is bigger than a whole batch
+	*/
+	BatchVertex* AllocateVertices(size_t count);
+
+	/**
+	* reserves 6 vertices (two triangles) per quad, see AllocateVertices
+	* @param count number of quads to reserve
+	* @returns pointer to the first vertex or null if the quads do not fit in a whole batch
+	*/
+	BatchVertex* AllocateQuads(size_t count);
+
+	/**
+	* encodes a bindless texture handle into the form BatchVertex::texture_handle stores it in
+	* @param textureHandle handle to encode (0 for no texture)
+	* @returns encoded handle
+	*/
+	static glm::vec2 PackTextureHandle(uint64_t textureHandle)
+	{
+		return glm::vec2((float)(textureHandle >> 32), (float)(textureHandle & 0xFFFFFFFF));
+	}
+
 
 private:
 	size_t numTriangles = 0;
 	size_t numVertices = 0;
 	const size_t maxTriangles = 100000;
 	const size_t maxVerticesPerBatch = maxTriangles * 3;
+	// the vertex buffer is persistently mapped and split into regions so the cpu writes one
+	// region while the gpu still reads the others, each region is fenced when it is drawn
+	static constexpr int BatchRegions = 3;
+	int region = 0;
+	Fence* regionFences[BatchRegions] = {};
+	BatchVertex* mappedVertices = nullptr;
 	BatchVertex* cpuBuffer;
 	Buffer* gpuBuffer;
 	VertexInput* vertexInput;
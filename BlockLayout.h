@@ -0,0 +1,206 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+#include <type_traits>
+#include <glm/glm.hpp>
+
+/**
+* memory layout rules of an interface block
+*/
+enum class BlockLayout
+{
+	Std140,
+	Std430,
+};
+
+/**
+* describes a type that can be a member of an interface block, every member is a scalar, a vector or a matrix
+* (an array of column vectors) of 4 byte components or a one dimensional array of those
+*/
+template<typename M>
+struct BlockType
+{
+	static constexpr bool Supported = false;
+	static constexpr size_t Components = 0;
+	static constexpr size_t Columns = 1;
+	static constexpr int ComponentType = 0;
+};
+
+// component types match GL_FLOAT, GL_INT and GL_UNSIGNED_INT
+#define JINGL_BLOCK_TYPE(Type, components, columns, componentType) \
+	template<> struct BlockType<Type> \
+	{ \
+		static constexpr bool Supported = true; \
+		static constexpr size_t Components = components; \
+		static constexpr size_t Columns = columns; \
+		static constexpr int ComponentType = componentType; \
+	}
+
+JINGL_BLOCK_TYPE(float, 1, 1, 0x1406);
+JINGL_BLOCK_TYPE(int32_t, 1, 1, 0x1404);
+JINGL_BLOCK_TYPE(uint32_t, 1, 1, 0x1405);
+JINGL_BLOCK_TYPE(glm::vec2, 2, 1, 0x1406);
+JINGL_BLOCK_TYPE(glm::vec3, 3, 1, 0x1406);
+JINGL_BLOCK_TYPE(glm::vec4, 4, 1, 0x1406);
+JINGL_BLOCK_TYPE(glm::ivec2, 2, 1, 0x1404);
+JINGL_BLOCK_TYPE(glm::ivec3, 3, 1, 0x1404);
+JINGL_BLOCK_TYPE(glm::ivec4, 4, 1, 0x1404);
+JINGL_BLOCK_TYPE(glm::uvec2, 2, 1, 0x1405);
+JINGL_BLOCK_TYPE(glm::uvec3, 3, 1, 0x1405);
+JINGL_BLOCK_TYPE(glm::uvec4, 4, 1, 0x1405);
+JINGL_BLOCK_TYPE(glm::mat2, 2, 2, 0x1406);
+JINGL_BLOCK_TYPE(glm::mat3, 3, 3, 0x1406);
+JINGL_BLOCK_TYPE(glm::mat4, 4, 4, 0x1406);
+
+/**
+* a member of a c++ struct mirroring an interface block, created by JINGL_BLOCK_LAYOUT
+*/
+struct BlockMember
+{
+	size_t offset;
+	size_t components;
+	size_t columns;
+	// array length, 0 if the member is not an array
+	size_t count;
+	// strides of the c++ type
+	size_t columnStride;
+	size_t elementStride;
+	int componentType;
+	bool supported;
+
+	template<typename M>
+	static constexpr BlockMember Of(size_t offset)
+	{
+		static_assert(std::rank_v<M> <= 1, "block members can only be one dimensional arrays");
+		using E = std::remove_extent_t<M>;
+		return { offset, BlockType<E>::Components, BlockType<E>::Columns, std::extent_v<M>,
+			sizeof(E) / BlockType<E>::Columns, sizeof(E), BlockType<E>::ComponentType, BlockType<E>::Supported };
+	}
+};
+
+constexpr size_t BlockAlignUp(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+* places a member after the previous ones following the layout rules
+* @param member member to place
+* @param layout layout rules
+* @param end end of the previous member, moved to the end of this one
+* @param alignment biggest base alignment seen so far
+* @returns false if the c++ offset or strides of the member differ from the layout
+*/
+constexpr bool PlaceBlockMember(const BlockMember& member, BlockLayout layout, size_t& end, size_t& alignment)
+{
+	if (!member.supported)
+		return false;
+
+	size_t base = member.components == 1 ? 4 : member.components == 2 ? 8 : 16;
+
+	// matrices and arrays are laid out as arrays of vectors, std140 rounds their alignment up to a vec4
+	bool aggregate = member.columns > 1 || member.count > 0;
+	if (aggregate && layout == BlockLayout::Std140)
+		base = BlockAlignUp(base, 16);
+
+	if (member.columns > 1 && member.columnStride != base)
+		return false;
+
+	size_t size = member.columns > 1 ? member.columns * base : member.components * 4;
+	size_t stride = BlockAlignUp(size, base);
+	if (member.count > 0 && member.elementStride != stride)
+		return false;
+
+	size_t offset = BlockAlignUp(end, base);
+	if (member.offset != offset)
+		return false;
+
+	end = offset + (member.count > 0 ? member.count * stride : size);
+	alignment = alignment > base ? alignment : base;
+	return true;
+}
+
+/**
+* checks that a struct described with JINGL_BLOCK_LAYOUT has the same memory layout as an interface block
+* @param layout layout rules of the block
+* @param array true if the struct is the element of an array (a runtime sized SSBO array for example) so its
+*	size also has to match the array stride
+* @returns true if every member is where the layout puts it
+*/
+template<typename T>
+constexpr bool CheckBlockLayout(BlockLayout layout, bool array)
+{
+	static_assert(std::is_standard_layout_v<T>, "block structs have to be standard layout");
+
+	size_t end = 0;
+	size_t alignment = 4;
+	for (const auto& member : T::BlockMembers())
+	{
+		if (!PlaceBlockMember(member, layout, end, alignment))
+			return false;
+	}
+
+	if (layout == BlockLayout::Std140)
+		alignment = BlockAlignUp(alignment, 16);
+
+	if (array)
+		return sizeof(T) == BlockAlignUp(end, alignment);
+
+	return sizeof(T) >= end;
+}
+
+#define JINGL_BLOCK_EXPAND(x) x
+#define JINGL_BLOCK_MEMBER(Type, member) BlockMember::Of<decltype(Type::member)>(offsetof(Type, member))
+#define JINGL_BLOCK_EACH_1(Type, member) JINGL_BLOCK_MEMBER(Type, member)
+#define JINGL_BLOCK_EACH_2(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_1(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_3(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_2(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_4(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_3(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_5(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_4(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_6(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_5(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_7(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_6(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_8(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_7(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_9(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_8(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_10(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_9(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_11(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_10(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_12(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_11(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_13(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_12(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_14(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_13(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_15(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_14(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_16(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_15(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_17(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_16(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_18(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_17(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_19(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_18(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_20(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_19(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_21(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_20(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_22(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_21(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_23(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_22(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_24(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_23(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_25(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_24(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_26(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_25(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_27(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_26(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_28(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_27(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_29(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_28(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_30(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_29(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_31(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_30(Type, __VA_ARGS__))
+#define JINGL_BLOCK_EACH_32(Type, member, ...) JINGL_BLOCK_MEMBER(Type, member), JINGL_BLOCK_EXPAND(JINGL_BLOCK_EACH_31(Type, __VA_ARGS__))
+#define JINGL_BLOCK_PICK(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, NAME, ...) NAME
+#define JINGL_BLOCK_EACH(Type, ...) JINGL_BLOCK_EXPAND(JINGL_BLOCK_PICK(__VA_ARGS__, JINGL_BLOCK_EACH_32, JINGL_BLOCK_EACH_31, JINGL_BLOCK_EACH_30, JINGL_BLOCK_EACH_29, JINGL_BLOCK_EACH_28, JINGL_BLOCK_EACH_27, JINGL_BLOCK_EACH_26, JINGL_BLOCK_EACH_25, JINGL_BLOCK_EACH_24, JINGL_BLOCK_EACH_23, JINGL_BLOCK_EACH_22, JINGL_BLOCK_EACH_21, JINGL_BLOCK_EACH_20, JINGL_BLOCK_EACH_19, JINGL_BLOCK_EACH_18, JINGL_BLOCK_EACH_17, JINGL_BLOCK_EACH_16, JINGL_BLOCK_EACH_15, JINGL_BLOCK_EACH_14, JINGL_BLOCK_EACH_13, JINGL_BLOCK_EACH_12, JINGL_BLOCK_EACH_11, JINGL_BLOCK_EACH_10, JINGL_BLOCK_EACH_9, JINGL_BLOCK_EACH_8, JINGL_BLOCK_EACH_7, JINGL_BLOCK_EACH_6, JINGL_BLOCK_EACH_5, JINGL_BLOCK_EACH_4, JINGL_BLOCK_EACH_3, JINGL_BLOCK_EACH_2, JINGL_BLOCK_EACH_1)(Type, __VA_ARGS__))
+
+/**
+* describes the members of a struct that mirrors an interface block, put it inside the struct and list every
+* member in declaration order. UniformBuffer / StorageBuffer check the description against the layout at compile time
+* and TypedBuffer turns it into vertex attributes
+*
+* struct Material
+* {
+*	glm::vec4 color;
+*	float roughness;
+*	float metallic;
+*	glm::vec2 padding;
+*
+*	JINGL_BLOCK_LAYOUT(Material, color, roughness, metallic, padding)
+* };
+*/
+#define JINGL_BLOCK_LAYOUT(Type, ...) \
+	static constexpr auto BlockMembers() { return std::array{ JINGL_BLOCK_EACH(Type, __VA_ARGS__) }; }
@@ -1,30 +1,105 @@
 #include "Buffer.h"
 #include "GL.h"
 
+#include <utility>
+
+Buffer::Buffer()
+	:id(0), size(0), storage(BufferStorage::None)
+{ }
+
 Buffer::Buffer(size_t size, void* data, bool dynamic)
 	:Buffer(size, data, dynamic, false, false)
 { }
 
 Buffer::Buffer(size_t size, void* data, bool dynamic, bool cpu_write, bool cpu_read)
+	:Buffer(size, data,
+		(dynamic ? BufferStorage::Dynamic : BufferStorage::None) |
+		(cpu_write ? BufferStorage::MapWrite : BufferStorage::None) |
+		(cpu_read ? BufferStorage::MapRead : BufferStorage::None))
+{ }
+
+Buffer::Buffer(size_t size, void* data, BufferStorage storage, MemoryCategory category)
+	:size(size), storage(storage), category(category)
 {
 	glCreateBuffers(1, &id);
-	int flags = 0;
-	if (dynamic) flags |= GL_DYNAMIC_STORAGE_BIT;
-	if (cpu_write) flags |= GL_MAP_WRITE_BIT;
-	if (cpu_read) flags |= GL_MAP_READ_BIT;
-	glNamedBufferStorage(id, size, data, flags);
+	glNamedBufferStorage(id, size, data, GLbitfield(storage));
+	GPUMemory::Allocate(category, size);
 }
 
 Buffer::~Buffer()
 {
+	if (id != 0)
+		GPUMemory::Free(category, size);
 	glDeleteBuffers(1, &id);
 }
 
+Buffer::Buffer(Buffer&& other) noexcept
+	:id(std::exchange(other.id, 0)), size(std::exchange(other.size, 0)), storage(other.storage), category(other.category)
+{ }
+
+Buffer& Buffer::operator=(Buffer&& other) noexcept
+{
+	if (this != &other)
+	{
+		if (id != 0)
+			GPUMemory::Free(category, size);
+		glDeleteBuffers(1, &id);
+		id = std::exchange(other.id, 0);
+		size = std::exchange(other.size, 0);
+		storage = other.storage;
+		category = other.category;
+	}
+	return *this;
+}
+
+void Buffer::SetCategory(MemoryCategory category)
+{
+	if (id != 0)
+	{
+		GPUMemory::Free(this->category, size);
+		GPUMemory::Allocate(category, size);
+	}
+	this->category = category;
+}
+
 void Buffer::SubData(size_t size, size_t offset, void* data)
 {
 	glNamedBufferSubData(id, offset, size, data);
 }
 
+void Buffer::Clear(unsigned int internalFormat, unsigned int format, unsigned int type, const void* value, size_t offset, size_t size)
+{
+	if (size == 0)
+		size = this->size - offset;
+
+	glClearNamedBufferSubData(id, internalFormat, offset, size, format, type, value);
+}
+
+void Buffer::ClearUInt(uint32_t value, size_t offset, size_t size)
+{
+	Clear(GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &value, offset, size);
+}
+
+void Buffer::ClearInt(int32_t value, size_t offset, size_t size)
+{
+	Clear(GL_R32I, GL_RED_INTEGER, GL_INT, &value, offset, size);
+}
+
+void Buffer::ClearFloat(float value, size_t offset, size_t size)
+{
+	Clear(GL_R32F, GL_RED, GL_FLOAT, &value, offset, size);
+}
+
+void Buffer::ClearVec4(const float value[4], size_t offset, size_t size)
+{
+	Clear(GL_RGBA32F, GL_RGBA, GL_FLOAT, value, offset, size);
+}
+
+void Buffer::CopyTo(Buffer& destination, size_t sourceOffset, size_t destinationOffset, size_t size) const
+{
+	glCopyNamedBufferSubData(id, destination.id, sourceOffset, destinationOffset, size);
+}
+
 void* Buffer::MapRead()
 {
 	return glMapNamedBuffer(id, GL_READ_ONLY);
@@ -40,6 +115,16 @@ void* Buffer::MapReadWrite()
 	return glMapNamedBuffer(id, GL_READ_WRITE);
 }
 
+void* Buffer::MapRange(size_t offset, size_t size, BufferMap access)
+{
+	return glMapNamedBufferRange(id, offset, size, GLbitfield(access));
+}
+
+void Buffer::FlushRange(size_t offset, size_t size)
+{
+	glFlushMappedNamedBufferRange(id, offset, size);
+}
+
 void Buffer::Unmap()
 {
 	glUnmapNamedBuffer(id);
@@ -49,3 +134,55 @@ void Buffer::BindAsSSBO(int index)
 {
 	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, id);
 }
+
+void Buffer::BindAsSSBO(int index, size_t offset, size_t size)
+{
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, index, id, offset, size);
+}
+
+void Buffer::BindAsUBO(int index)
+{
+	glBindBufferBase(GL_UNIFORM_BUFFER, index, id);
+}
+
+void Buffer::BindAsUBO(int index, size_t offset, size_t size)
+{
+	glBindBufferRange(GL_UNIFORM_BUFFER, index, id, offset, size);
+}
+
+void BufferCopyList::Add(const Buffer& source, size_t sourceOffset, const Buffer& destination, size_t destinationOffset, size_t size)
+{
+	if (size == 0)
+		return;
+
+	bytes += size;
+
+	if (!copies.empty())
+	{
+		auto& last = copies.back();
+		bool contiguous = last.source == source.GetID() && last.destination == destination.GetID() &&
+			last.sourceOffset + last.size == sourceOffset && last.destinationOffset + last.size == destinationOffset;
+
+		// within one buffer the merged ranges must not overlap, 0->16 then 16->32 would read what the first copy wrote
+		size_t merged = last.size + size;
+		bool overlapping = last.source == last.destination &&
+			last.sourceOffset < last.destinationOffset + merged && last.destinationOffset < last.sourceOffset + merged;
+
+		if (contiguous && !overlapping)
+		{
+			last.size += size;
+			return;
+		}
+	}
+
+	copies.push_back({ source.GetID(), destination.GetID(), sourceOffset, destinationOffset, size });
+}
+
+void BufferCopyList::Submit()
+{
+	for (const auto& copy : copies)
+		glCopyNamedBufferSubData(copy.source, copy.destination, copy.sourceOffset, copy.destinationOffset, copy.size);
+
+	copies.clear();
+	bytes = 0;
+}
\ No newline at end of file
@@ -1,8 +1,52 @@
 #pragma once
+#include "GPUMemory.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+* storage flags of a buffer (values match GL_*_BIT passed to glNamedBufferStorage)
+*/
+enum class BufferStorage : unsigned int
+{
+	None = 0,
+	MapRead = 0x0001,
+	MapWrite = 0x0002,
+	MapPersistent = 0x0040,
+	MapCoherent = 0x0080,
+	Dynamic = 0x0100,
+	ClientStorage = 0x0200,
+};
+
+/**
+* access flags of a mapping (values match GL_MAP_*_BIT passed to glMapNamedBufferRange)
+*/
+enum class BufferMap : unsigned int
+{
+	Read = 0x0001,
+	Write = 0x0002,
+	InvalidateRange = 0x0004,
+	InvalidateBuffer = 0x0008,
+	FlushExplicit = 0x0010,
+	Unsynchronized = 0x0020,
+	Persistent = 0x0040,
+	Coherent = 0x0080,
+};
+
+constexpr BufferStorage operator|(BufferStorage a, BufferStorage b) { return BufferStorage((unsigned int)a | (unsigned int)b); }
+constexpr bool operator&(BufferStorage a, BufferStorage b) { return ((unsigned int)a & (unsigned int)b) != 0; }
+constexpr BufferMap operator|(BufferMap a, BufferMap b) { return BufferMap((unsigned int)a | (unsigned int)b); }
+constexpr bool operator&(BufferMap a, BufferMap b) { return ((unsigned int)a & (unsigned int)b) != 0; }
 
 class Buffer
 {
 public:
+	/**
+	* creates an empty buffer without an OpenGL handle (GetID returns 0), move a real buffer into it later
+	*/
+	Buffer();
+
 	/**
 	* creates a buffer
 	* @param size size of buffer to allocate
@@ -13,12 +57,32 @@ public:
 	explicit Buffer(size_t size, void* data, bool dynamic);
 	explicit Buffer(size_t size, void* data, bool dynamic, bool cpu_write, bool cpu_read);
 
+	/**
+	* creates a buffer with explicit storage flags
+	* @param size size of buffer to allocate
+	* @param data pointer to cpu side data to upload (can be null)
+	* @param storage storage flags, a buffer has to be created with MapPersistent / MapCoherent
+	*	to be mapped with them
+	* @param category category the memory of the buffer is accounted in (see GPUMemory)
+	*/
+	explicit Buffer(size_t size, void* data, BufferStorage storage, MemoryCategory category = MemoryCategory::Other);
+
 	/**
 	* Destroys the buffer and de-allocates all the memory
 	* @note since the de-allocation is done by the driver we have to control over it
 	*/
 	~Buffer();
 
+	Buffer(const Buffer&) = delete;
+	Buffer& operator=(const Buffer&) = delete;
+
+	/**
+	* takes over the OpenGL handle of another buffer, the other one is left empty and can only be destroyed or assigned to
+	* @param other buffer to move from
+	*/
+	Buffer(Buffer&& other) noexcept;
+	Buffer& operator=(Buffer&& other) noexcept;
+
 	/**
 	* updates / sets the data of the buffer (if the buffe is dynamic only)
 	* @param size size of data to upload
@@ -27,19 +91,169 @@ public:
 	*/
 	void SubData(size_t size, size_t offset, void* data);
 
+	/**
+	* fills a range of the buffer with a 32 bit unsigned value on the gpu (glClearNamedBufferSubData)
+	* @param value value to repeat
+	* @param offset offset of the range (multiple of 4)
+	* @param size size of the range in bytes (multiple of 4), 0 for the rest of the buffer
+	*/
+	void ClearUInt(uint32_t value, size_t offset = 0, size_t size = 0);
+
+	/**
+	* fills a range of the buffer with a 32 bit signed value on the gpu, see ClearUInt
+	*/
+	void ClearInt(int32_t value, size_t offset = 0, size_t size = 0);
+
+	/**
+	* fills a range of the buffer with a float on the gpu, see ClearUInt
+	*/
+	void ClearFloat(float value, size_t offset = 0, size_t size = 0);
+
+	/**
+	* fills a range of the buffer with a vec4 on the gpu
+	* @param value 4 floats to repeat
+	* @param offset offset of the range (multiple of 16)
+	* @param size size of the range in bytes (multiple of 16), 0 for the rest of the buffer
+	*/
+	void ClearVec4(const float value[4], size_t offset = 0, size_t size = 0);
+
+	/**
+	* copies a range of this buffer into another buffer on the gpu (glCopyNamedBufferSubData)
+	* @param destination buffer to copy into (can be this buffer if the ranges do not overlap)
+	* @param sourceOffset offset of the range in this buffer
+	* @param destinationOffset offset of the range in the destination
+	* @param size size of the range in bytes
+	*/
+	void CopyTo(Buffer& destination, size_t sourceOffset, size_t destinationOffset, size_t size) const;
+
 	/**
 	* gets the id of underlying OpenGL handle
 	* @returns id
 	*/
 	unsigned int GetID() const { return id; }
 
+	/**
+	* gets the size of the buffer
+	* @returns size in bytes
+	*/
+	size_t GetSize() const { return size; }
+
+	/**
+	* gets the storage flags the buffer was created with
+	* @returns storage flags
+	*/
+	BufferStorage GetStorage() const { return storage; }
+
+	/**
+	* moves the memory of the buffer to another accounting category (see GPUMemory)
+	* @param category new category
+	*/
+	void SetCategory(MemoryCategory category);
+
+	/**
+	* gets the accounting category of the buffer
+	* @returns category
+	*/
+	MemoryCategory GetCategory() const { return category; }
+
 	void* MapRead();
 	void* MapWrite();
 	void* MapReadWrite();
+
+	/**
+	* maps a range of the buffer
+	* @param offset offset into the buffer of the range
+	* @param size size of the range in bytes
+	* @param access access flags, use Unsynchronized / InvalidateRange to avoid waiting on the gpu and
+	*	FlushExplicit to only make the ranges passed to FlushRange visible
+	* @returns pointer to the mapped range or null on failure
+	*/
+	void* MapRange(size_t offset, size_t size, BufferMap access);
+
+	/**
+	* makes writes to a part of a range mapped with FlushExplicit visible to the gpu
+	* @param offset offset relative to the start of the mapped range
+	* @param size size of the written data in bytes
+	*/
+	void FlushRange(size_t offset, size_t size);
+
 	void Unmap();
 
 	void BindAsSSBO(int index);
 
+	/**
+	* binds a range of the buffer as a shader storage buffer
+	* @param index binding point
+	* @param offset offset of the range (multiple of GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT)
+	* @param size size of the range in bytes
+	*/
+	void BindAsSSBO(int index, size_t offset, size_t size);
+
+	/**
+	* binds the buffer as a uniform buffer
+	* @param index binding point
+	*/
+	void BindAsUBO(int index);
+
+	/**
+	* binds a range of the buffer as a uniform buffer
+	* @param index binding point
+	* @param offset offset of the range (multiple of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT)
+	* @param size size of the range in bytes
+	*/
+	void BindAsUBO(int index, size_t offset, size_t size);
+
 private:
+	void Clear(unsigned int internalFormat, unsigned int format, unsigned int type, const void* value, size_t offset, size_t size);
+
 	unsigned int id;
+	size_t size;
+	BufferStorage storage;
+	MemoryCategory category = MemoryCategory::Other;
+};
+
+class BufferCopyList
+{
+public:
+	/**
+	* queues a copy, a copy that continues the previous one (same buffers, both ranges contiguous) is merged into it.
+	*	copies within one buffer are only merged if the merged ranges do not overlap, so 0->16 then 16->32 stay two
+	*	copies and the second one reads what the first one wrote
+	* @param source buffer to copy from
+	* @param sourceOffset offset of the range in the source
+	* @param destination buffer to copy into
+	* @param destinationOffset offset of the range in the destination
+	* @param size size of the range in bytes
+	*/
+	void Add(const Buffer& source, size_t sourceOffset, const Buffer& destination, size_t destinationOffset, size_t size);
+
+	/**
+	* issues all the queued copies in the order they were added and empties the list
+	*/
+	void Submit();
+
+	/**
+	* gets the number of copies that will be issued (after merging)
+	* @returns count
+	*/
+	size_t GetCount() const { return copies.size(); }
+
+	/**
+	* gets the number of bytes queued
+	* @returns bytes
+	*/
+	size_t GetBytes() const { return bytes; }
+
+private:
+	struct Copy
+	{
+		unsigned int source;
+		unsigned int destination;
+		size_t sourceOffset;
+		size_t destinationOffset;
+		size_t size;
+	};
+
+	std::vector<Copy> copies;
+	size_t bytes = 0;
 };
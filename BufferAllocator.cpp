@@ -0,0 +1,349 @@
+#include "BufferAllocator.h"
+#include "GL.h"
+
+#include <algorithm>
+#include <bit>
+
+static size_t AlignUp(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static size_t RoundUpToClass(size_t size, size_t granularity, int slBits)
+{
+	// rounds up so every block in the found list is big enough
+	size_t units = size / granularity;
+	if (units >= ((size_t)1 << slBits))
+		units += ((size_t)1 << (std::bit_width(units) - 1 - slBits)) - 1;
+	return units * granularity;
+}
+
+BufferAllocator::BufferAllocator(size_t poolSize, BufferStorage storage, size_t alignment, MemoryCategory category)
+	:storage(storage), category(category)
+{
+	if (alignment == 0)
+	{
+		int uniformAlignment = 0;
+		int storageAlignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+		glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+		alignment = (size_t)std::max(uniformAlignment, storageAlignment);
+	}
+
+	granularity = std::bit_ceil(std::max(alignment, (size_t)16));
+	this->poolSize = AlignUp(poolSize, granularity);
+
+	for (auto& level : heads)
+		for (auto& head : level)
+			head = None;
+}
+
+BufferAllocator::~BufferAllocator()
+{
+	for (auto& pool : pools)
+		delete pool.buffer;
+	pools.clear();
+}
+
+uint32_t BufferAllocator::NewBlock()
+{
+	if (!unusedBlocks.empty())
+	{
+		auto block = unusedBlocks.back();
+		unusedBlocks.pop_back();
+		return block;
+	}
+
+	blocks.push_back({});
+	return (uint32_t)blocks.size() - 1;
+}
+
+void BufferAllocator::ReleaseBlock(uint32_t block)
+{
+	unusedBlocks.push_back(block);
+}
+
+void BufferAllocator::Mapping(size_t size, int& fl, int& sl) const
+{
+	size_t units = size / granularity;
+
+	// small sizes get one exact list each
+	if (units < SLCount)
+	{
+		fl = 0;
+		sl = (int)units;
+		return;
+	}
+
+	int msb = (int)std::bit_width(units) - 1;
+	fl = msb - SLBits + 1;
+	sl = (int)((units >> (msb - SLBits)) & (SLCount - 1));
+}
+
+void BufferAllocator::InsertFree(uint32_t block)
+{
+	int fl, sl;
+	Mapping(blocks[block].size, fl, sl);
+
+	auto& b = blocks[block];
+	b.free = true;
+	b.prevFree = None;
+	b.nextFree = heads[fl][sl];
+	if (b.nextFree != None)
+		blocks[b.nextFree].prevFree = block;
+
+	heads[fl][sl] = block;
+	flBitmap |= 1ull << fl;
+	slBitmap[fl] |= 1u << sl;
+}
+
+void BufferAllocator::RemoveFree(uint32_t block)
+{
+	int fl, sl;
+	Mapping(blocks[block].size, fl, sl);
+
+	auto& b = blocks[block];
+	if (b.prevFree != None) blocks[b.prevFree].nextFree = b.nextFree;
+	if (b.nextFree != None) blocks[b.nextFree].prevFree = b.prevFree;
+
+	if (heads[fl][sl] == block)
+	{
+		heads[fl][sl] = b.nextFree;
+		if (heads[fl][sl] == None)
+		{
+			slBitmap[fl] &= ~(1u << sl);
+			if (slBitmap[fl] == 0)
+				flBitmap &= ~(1ull << fl);
+		}
+	}
+
+	b.free = false;
+	b.prevFree = b.nextFree = None;
+}
+
+uint32_t BufferAllocator::FindFree(size_t size) const
+{
+	int fl, sl;
+	Mapping(RoundUpToClass(size, granularity, SLBits), fl, sl);
+	if (fl >= FLCount)
+		return None;
+
+	uint32_t slMap = slBitmap[fl] & (~0u << sl);
+	if (slMap == 0)
+	{
+		uint64_t flMap = fl + 1 < FLCount ? flBitmap & (~0ull << (fl + 1)) : 0;
+		if (flMap == 0)
+			return None;
+
+		fl = std::countr_zero(flMap);
+		slMap = slBitmap[fl];
+	}
+
+	sl = std::countr_zero(slMap);
+	return heads[fl][sl];
+}
+
+uint32_t BufferAllocator::FindLowestFree(size_t size, size_t alignment, uint32_t before) const
+{
+	// the size classes only give a good fit, compaction needs the lowest address so walk the pools in address order
+	const auto& limit = blocks[before];
+	for (uint32_t p = 0; p <= limit.pool; p++)
+	{
+		for (auto block = pools[p].firstBlock; block != None; block = blocks[block].nextPhysical)
+		{
+			const auto& b = blocks[block];
+			if (p == limit.pool && b.offset >= limit.offset)
+				return None;
+
+			if (b.free && AlignUp(b.offset, alignment) - b.offset + size <= b.size)
+				return block;
+		}
+	}
+
+	return None;
+}
+
+uint32_t BufferAllocator::SplitTail(uint32_t block, size_t size)
+{
+	auto tail = NewBlock();
+	auto& t = blocks[tail];
+	auto& b = blocks[block];
+
+	t.offset = b.offset + size;
+	t.size = b.size - size;
+	t.alignment = granularity;
+	t.pool = b.pool;
+	t.prevPhysical = block;
+	t.nextPhysical = b.nextPhysical;
+	t.prevFree = t.nextFree = None;
+	t.free = false;
+
+	if (b.nextPhysical != None)
+		blocks[b.nextPhysical].prevPhysical = tail;
+
+	b.nextPhysical = tail;
+	b.size = size;
+	return tail;
+}
+
+uint32_t BufferAllocator::Carve(uint32_t block, size_t size, size_t alignment)
+{
+	// block is free and already removed from its list
+	size_t padding = AlignUp(blocks[block].offset, alignment) - blocks[block].offset;
+	if (padding > 0)
+	{
+		auto rest = SplitTail(block, padding);
+		InsertFree(block);
+		block = rest;
+	}
+
+	if (blocks[block].size > size)
+		InsertFree(SplitTail(block, size));
+
+	blocks[block].free = false;
+	blocks[block].alignment = alignment;
+	allocatedBytes += size;
+	return block;
+}
+
+uint32_t BufferAllocator::FreeBlock(uint32_t block)
+{
+	allocatedBytes -= blocks[block].size;
+
+	auto prev = blocks[block].prevPhysical;
+	if (prev != None && blocks[prev].free)
+	{
+		RemoveFree(prev);
+		blocks[prev].size += blocks[block].size;
+		blocks[prev].nextPhysical = blocks[block].nextPhysical;
+		if (blocks[block].nextPhysical != None)
+			blocks[blocks[block].nextPhysical].prevPhysical = prev;
+
+		ReleaseBlock(block);
+		block = prev;
+	}
+
+	auto next = blocks[block].nextPhysical;
+	if (next != None && blocks[next].free)
+	{
+		RemoveFree(next);
+		blocks[block].size += blocks[next].size;
+		blocks[block].nextPhysical = blocks[next].nextPhysical;
+		if (blocks[next].nextPhysical != None)
+			blocks[blocks[next].nextPhysical].prevPhysical = block;
+
+		ReleaseBlock(next);
+	}
+
+	InsertFree(block);
+	return block;
+}
+
+void BufferAllocator::AddPool(size_t size)
+{
+	auto block = NewBlock();
+	blocks[block] = { 0, size, granularity, (uint32_t)pools.size(), None, None, None, None, false };
+
+	pools.push_back({ new Buffer(size, nullptr, storage, category), block });
+	capacity += size;
+	InsertFree(block);
+}
+
+BufferAllocation BufferAllocator::MakeAllocation(uint32_t block) const
+{
+	const auto& b = blocks[block];
+	return { pools[b.pool].buffer, b.offset, b.size, block };
+}
+
+BufferAllocation BufferAllocator::Allocate(size_t size, size_t alignment)
+{
+	if (size == 0)
+		return { nullptr, 0, 0, None };
+
+	size = AlignUp(size, granularity);
+	alignment = alignment <= granularity ? granularity : std::bit_ceil(alignment);
+
+	// worst case padding needed to align the offset
+	size_t request = size + alignment - granularity;
+
+	auto block = FindFree(request);
+	if (block == None)
+	{
+		AddPool(std::max(poolSize, RoundUpToClass(request, granularity, SLBits)));
+		block = FindFree(request);
+	}
+
+	if (block == None)
+		return { nullptr, 0, 0, None };
+
+	RemoveFree(block);
+	return MakeAllocation(Carve(block, size, alignment));
+}
+
+void BufferAllocator::Free(const BufferAllocation& allocation)
+{
+	if (!allocation.IsValid() || allocation.block == None)
+		return;
+
+	FreeBlock(allocation.block);
+}
+
+size_t BufferAllocator::Defragment(size_t maxBytes, const std::function<void(const BufferAllocation& from, const BufferAllocation& to)>& moved)
+{
+	size_t copied = 0;
+
+	// walk from the end of the last pool backwards so the tail empties first
+	for (int p = (int)pools.size() - 1; p >= 0 && copied < maxBytes; p--)
+	{
+		auto block = pools[p].firstBlock;
+		while (blocks[block].nextPhysical != None)
+			block = blocks[block].nextPhysical;
+
+		while (block != None && copied < maxBytes)
+		{
+			const auto& b = blocks[block];
+			if (b.free)
+			{
+				block = b.prevPhysical;
+				continue;
+			}
+
+			size_t size = b.size;
+			size_t alignment = b.alignment;
+			auto target = FindLowestFree(size, alignment, block);
+			if (target == None)
+			{
+				block = b.prevPhysical;
+				continue;
+			}
+
+			RemoveFree(target);
+			target = Carve(target, size, alignment);
+
+			auto from = MakeAllocation(block);
+			auto to = MakeAllocation(target);
+			from.buffer->CopyTo(*to.buffer, from.offset, to.offset, size);
+			moved(from, to);
+			copied += size;
+
+			block = blocks[FreeBlock(block)].prevPhysical;
+		}
+	}
+
+	// pools left completely free at the end are given back to the driver
+	while (pools.size() > 1)
+	{
+		auto& pool = pools.back();
+		auto& first = blocks[pool.firstBlock];
+		if (!first.free || first.nextPhysical != None)
+			break;
+
+		RemoveFree(pool.firstBlock);
+		ReleaseBlock(pool.firstBlock);
+		capacity -= first.size;
+		delete pool.buffer;
+		pools.pop_back();
+	}
+
+	return copied;
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include "Buffer.h"
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+struct BufferAllocation
+{
+	// buffer the range lives in (null if the allocation failed)
+	Buffer* buffer;
+	size_t offset;
+	size_t size;
+	// internal handle used by Free
+	uint32_t block;
+
+	bool IsValid() const { return buffer != nullptr; }
+};
+
+class BufferAllocator
+{
+public:
+	/**
+	* creates a sub-allocator, large buffers (pools) are created on demand and carved into aligned ranges
+	* with a TLSF (two level segregated fit) allocator so allocating and freeing are O(1)
+	* @param poolSize size of every pool buffer (bigger allocations get a pool of their own)
+	* @param storage storage flags of the pool buffers
+	* @param alignment minimum alignment of every range, 0 to use the largest of the uniform and shader storage
+	*	buffer offset alignments so every range can be bound with BindAsSSBO / glBindBufferRange
+	* @param category memory accounting category of the pool buffers (see GPUMemory)
+	*/
+	explicit BufferAllocator(size_t poolSize, BufferStorage storage = BufferStorage::Dynamic, size_t alignment = 0,
+		MemoryCategory category = MemoryCategory::Vertex);
+
+	/**
+	* destroys all the pools, all the allocations are invalid after this
+	*/
+	~BufferAllocator();
+
+	/**
+	* allocates a range
+	* @param size size of the range in bytes
+	* @param alignment alignment of the offset of the range (0 for the minimum alignment)
+	* @returns the allocation, check IsValid
+	*/
+	BufferAllocation Allocate(size_t size, size_t alignment = 0);
+
+	/**
+	* frees a range
+	* @param allocation allocation returned by Allocate (or passed as the new range to a Defragment callback)
+	*/
+	void Free(const BufferAllocation& allocation);
+
+	/**
+	* moves allocations into the lowest free space that fits with glCopyNamedBufferSubData, starting from the end of
+	* the last pool, and destroys the pools left empty at the end. meant to be called once per frame with a small budget.
+	* an allocation only moves if a free range before it is big enough, so fragments smaller than the live
+	* allocations can keep a pool alive
+	* @param maxBytes maximum number of bytes to copy
+	* @param moved called for every moved allocation with the old and new range, the owner has to switch
+	*	to the new range (the old one is freed)
+	* @returns number of bytes copied
+	*/
+	size_t Defragment(size_t maxBytes, const std::function<void(const BufferAllocation& from, const BufferAllocation& to)>& moved);
+
+	/**
+	* gets the number of bytes in live allocations (including alignment rounding)
+	* @returns bytes
+	*/
+	size_t GetAllocatedBytes() const { return allocatedBytes; }
+
+	/**
+	* gets the total size of all the pools
+	* @returns bytes
+	*/
+	size_t GetCapacity() const { return capacity; }
+
+	/**
+	* gets the number of pool buffers
+	* @returns count
+	*/
+	size_t GetPoolCount() const { return pools.size(); }
+
+private:
+	static constexpr uint32_t None = 0xFFFFFFFF;
+	static constexpr int SLBits = 4;
+	static constexpr int SLCount = 1 << SLBits;
+	static constexpr int FLCount = 64;
+
+	struct Block
+	{
+		size_t offset;
+		size_t size;
+		size_t alignment;
+		uint32_t pool;
+		uint32_t prevPhysical, nextPhysical;
+		uint32_t prevFree, nextFree;
+		bool free;
+	};
+
+	struct Pool
+	{
+		Buffer* buffer;
+		uint32_t firstBlock;
+	};
+
+	uint32_t NewBlock();
+	void ReleaseBlock(uint32_t block);
+	void Mapping(size_t size, int& fl, int& sl) const;
+	void InsertFree(uint32_t block);
+	void RemoveFree(uint32_t block);
+	uint32_t FindFree(size_t size) const;
+	uint32_t FindLowestFree(size_t size, size_t alignment, uint32_t before) const;
+	uint32_t SplitTail(uint32_t block, size_t size);
+	uint32_t Carve(uint32_t block, size_t size, size_t alignment);
+	uint32_t FreeBlock(uint32_t block);
+	void AddPool(size_t size);
+	BufferAllocation MakeAllocation(uint32_t block) const;
+
+	size_t poolSize;
+	BufferStorage storage;
+	MemoryCategory category;
+	size_t granularity;
+	size_t allocatedBytes = 0;
+	size_t capacity = 0;
+
+	std::vector<Block> blocks;
+	std::vector<uint32_t> unusedBlocks;
+	std::vector<Pool> pools;
+
+	uint64_t flBitmap = 0;
+	uint32_t slBitmap[FLCount] = {};
+	uint32_t heads[FLCount][SLCount];
+};
@@ -0,0 +1,69 @@
+#include "ComputeProgram.h"
+#include "GL.h"
+
+void IssueBarrier(Barrier barriers)
+{
+	glMemoryBarrier((unsigned int)barriers);
+}
+
+void IssueBarrierByRegion(Barrier barriers)
+{
+	glMemoryBarrierByRegion((unsigned int)barriers);
+}
+
+ComputeProgram::ComputeProgram()
+	:ShaderProgram()
+{ }
+
+ComputeProgram::ComputeProgram(const std::string& source)
+	:ComputeProgram(new Shader(ShaderType::Compute, source))
+{ }
+
+ComputeProgram::ComputeProgram(const std::vector<uint32_t>& spirv, const std::vector<SpecializationConstant>& constants)
+	:ComputeProgram(new Shader(ShaderType::Compute, spirv, constants))
+{ }
+
+ComputeProgram::ComputeProgram(Shader* shader)
+	:ShaderProgram()
+{
+	AttachShader(shader);
+
+	char* log;
+	if (!Link(&log, nullptr))
+	{
+		printf("SHADER LINK ERROR: %s", log);
+		delete[] log;
+	}
+}
+
+uint32_t ComputeProgram::GetWorkGroupSize(int axis) const
+{
+	if (workGroupSize[0] == 0 && IsValid())
+		glGetProgramiv(GetID(), GL_COMPUTE_WORK_GROUP_SIZE, workGroupSize);
+
+	return (uint32_t)workGroupSize[axis];
+}
+
+void ComputeProgram::Dispatch(uint32_t x, uint32_t y, uint32_t z) const
+{
+	Bind();
+	glDispatchCompute(x, y, z);
+}
+
+void ComputeProgram::DispatchThreads(uint32_t x, uint32_t y, uint32_t z) const
+{
+	uint32_t sizeX = GetWorkGroupSize(0);
+	uint32_t sizeY = GetWorkGroupSize(1);
+	uint32_t sizeZ = GetWorkGroupSize(2);
+	if (sizeX == 0 || sizeY == 0 || sizeZ == 0)
+		return;
+
+	Dispatch((x + sizeX - 1) / sizeX, (y + sizeY - 1) / sizeY, (z + sizeZ - 1) / sizeZ);
+}
+
+void ComputeProgram::DispatchIndirect(const Buffer& buffer, size_t offset) const
+{
+	Bind();
+	glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, buffer.GetID());
+	glDispatchComputeIndirect((intptr_t)offset);
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include "Shader.h"
+#include "Buffer.h"
+
+/**
+* what the commands after a barrier read that earlier shader writes have to be visible to
+* (values match GL_*_BARRIER_BIT passed to glMemoryBarrier), only the bits of the actual consumers should be issued
+*/
+enum class Barrier : unsigned int
+{
+	// vertex attributes sourced from buffers written by shaders
+	VertexAttribArray = 0x00000001,
+	// indices sourced from buffers written by shaders
+	ElementArray = 0x00000002,
+	// uniform blocks sourced from buffers written by shaders
+	Uniform = 0x00000004,
+	// texture fetches (sampler reads) of textures written by shaders
+	TextureFetch = 0x00000008,
+	// image loads / stores / atomics after image writes
+	ShaderImageAccess = 0x00000020,
+	// indirect draw / dispatch arguments written by shaders
+	Command = 0x00000040,
+	// pixel pack / unpack (glReadPixels, uploads through a pixel buffer) of buffers written by shaders
+	PixelBuffer = 0x00000080,
+	// glTextureSubImage / glGetTextureImage of textures written by shaders
+	TextureUpdate = 0x00000100,
+	// buffer copies, clears, SubData and mapping of buffers written by shaders
+	BufferUpdate = 0x00000200,
+	// framebuffer reads and writes of attachments written by shaders
+	Framebuffer = 0x00000400,
+	// transform feedback of buffers written by shaders
+	TransformFeedback = 0x00000800,
+	// atomic counters after atomic counter writes
+	AtomicCounter = 0x00001000,
+	// shader storage block reads / writes / atomics after shader storage writes
+	ShaderStorage = 0x00002000,
+	// client reads of persistent mappings without the coherent flag
+	ClientMappedBuffer = 0x00004000,
+	// query results written into buffers
+	QueryBuffer = 0x00008000,
+	All = 0xFFFFFFFF,
+};
+
+constexpr Barrier operator|(Barrier a, Barrier b) { return Barrier((unsigned int)a | (unsigned int)b); }
+
+/**
+* makes the writes of previous shaders visible to the given kinds of later reads (glMemoryBarrier)
+* @param barriers kinds of reads that consume the writes
+*/
+void IssueBarrier(Barrier barriers);
+
+/**
+* same as IssueBarrier but only orders fragment shader accesses of the same framebuffer region (glMemoryBarrierByRegion),
+* cheaper on tiled gpus. only ShaderImageAccess, ShaderStorage, AtomicCounter, TextureFetch, Uniform and Framebuffer apply
+* @param barriers kinds of reads that consume the writes
+*/
+void IssueBarrierByRegion(Barrier barriers);
+
+class ComputeProgram : public ShaderProgram
+{
+public:
+	/**
+	* creates an empty compute program, attach a compute shader and link it (or load a binary)
+	*/
+	explicit ComputeProgram();
+
+	/**
+	* creates a compute program and links it with a compute shader compiled from source
+	* @param source glsl source of the compute shader
+	*/
+	explicit ComputeProgram(const std::string& source);
+
+	/**
+	* creates a compute program and links it with a compute shader loaded from a SPIR-V module, i.e the local size can be
+	* specialized with layout(local_size_x_id = 0) in; and read back with GetWorkGroupSize
+	* @param spirv words of the module
+	* @param constants values of the specialization constants
+	*/
+	explicit ComputeProgram(const std::vector<uint32_t>& spirv, const std::vector<SpecializationConstant>& constants = {});
+
+	/**
+	* binds the program and dispatches work groups
+	* @param x number of work groups in x
+	* @param y number of work groups in y
+	* @param z number of work groups in z
+	*/
+	void Dispatch(uint32_t x, uint32_t y = 1, uint32_t z = 1) const;
+
+	/**
+	* binds the program and dispatches enough work groups to cover a number of invocations with the
+	* reflected local size, the shader has to skip the invocations past the end
+	* @param x number of invocations in x
+	* @param y number of invocations in y
+	* @param z number of invocations in z
+	*/
+	void DispatchThreads(uint32_t x, uint32_t y = 1, uint32_t z = 1) const;
+
+	/**
+	* binds the program and dispatches with the work group counts read by the gpu from a buffer, three uint32_t.
+	* issue Barrier::Command first if a shader wrote them
+	* @param buffer buffer holding the counts
+	* @param offset offset of the counts in the buffer (multiple of 4)
+	*/
+	void DispatchIndirect(const Buffer& buffer, size_t offset) const;
+
+	/**
+	* gets the local size the shader was compiled with (layout(local_size_x = ...) in)
+	* @param axis 0, 1 or 2 for x, y or z
+	* @returns number of invocations per work group along the axis
+	*/
+	uint32_t GetWorkGroupSize(int axis) const;
+
+private:
+	explicit ComputeProgram(Shader* shader);
+
+	// queried on first use so programs linked asynchronously or loaded from binaries work as well
+	mutable int workGroupSize[3] = {};
+};
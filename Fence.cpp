@@ -0,0 +1,119 @@
+#include "Fence.h"
+#include "GL.h"
+
+#include <stdio.h>
+#include <chrono>
+#include <utility>
+
+Fence::Fence()
+{
+	sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+Fence::~Fence()
+{
+	glDeleteSync((GLsync)sync);
+}
+
+Fence::Fence(Fence&& other) noexcept
+	:sync(std::exchange(other.sync, nullptr)), flushed(other.flushed), signaled(other.signaled)
+{ }
+
+Fence& Fence::operator=(Fence&& other) noexcept
+{
+	if (this != &other)
+	{
+		glDeleteSync((GLsync)sync);
+		sync = std::exchange(other.sync, nullptr);
+		flushed = other.flushed;
+		signaled = other.signaled;
+	}
+	return *this;
+}
+
+bool Fence::Poll(uint64_t timeout)
+{
+	if (signaled)
+		return true;
+
+	// the first check flushes so the fence is guaranteed to reach the gpu
+	GLbitfield flags = flushed ? 0 : GL_SYNC_FLUSH_COMMANDS_BIT;
+	flushed = true;
+
+	auto status = glClientWaitSync((GLsync)sync, flags, timeout);
+	if (status == GL_WAIT_FAILED)
+	{
+		printf("Fence wait failed\n");
+		// nothing will ever signal it so waiting on it again would hang
+		signaled = true;
+	}
+	else
+	{
+		signaled = status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+	}
+
+	return signaled;
+}
+
+bool Fence::IsSignaled()
+{
+	return Poll(0);
+}
+
+bool Fence::Wait(uint64_t timeout)
+{
+	return Poll(timeout);
+}
+
+FrameTracker::FrameTracker(int framesInFlight)
+	:framesInFlight(framesInFlight < 1 ? 1 : framesInFlight)
+{
+
+}
+
+FrameTracker::~FrameTracker()
+{
+	for (auto& p : pending)
+		delete p.fence;
+	pending.clear();
+}
+
+void FrameTracker::BeginFrame()
+{
+	waitTime = 0.0;
+	GetCompletedFrames();
+
+	if ((int)pending.size() < framesInFlight)
+		return;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	while ((int)pending.size() >= framesInFlight)
+	{
+		auto& oldest = pending.front();
+		oldest.fence->Wait();
+		completedFrames = oldest.frame + 1;
+		delete oldest.fence;
+		pending.pop_front();
+	}
+	waitTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	totalWaitTime += waitTime;
+}
+
+void FrameTracker::EndFrame()
+{
+	pending.push_back({ frame, new Fence() });
+	frame++;
+}
+
+uint64_t FrameTracker::GetCompletedFrames()
+{
+	// fences signal in order so only the oldest ones need checking
+	while (!pending.empty() && pending.front().fence->IsSignaled())
+	{
+		completedFrames = pending.front().frame + 1;
+		delete pending.front().fence;
+		pending.pop_front();
+	}
+
+	return completedFrames;
+}
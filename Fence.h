@@ -0,0 +1,125 @@
+#pragma once
+
+#include <stdint.h>
+#include <deque>
+
+class Fence
+{
+public:
+	/**
+	* inserts a fence into the command stream, it is signaled once the gpu has finished every command issued before it
+	*/
+	Fence();
+
+	/**
+	* deletes the fence (it does not wait for it)
+	*/
+	~Fence();
+
+	Fence(const Fence&) = delete;
+	Fence& operator=(const Fence&) = delete;
+
+	/**
+	* takes over the sync object of another fence, the other one is left empty
+	* @param other fence to move from
+	*/
+	Fence(Fence&& other) noexcept;
+	Fence& operator=(Fence&& other) noexcept;
+
+	/**
+	* checks if the gpu has passed the fence without blocking
+	* @returns true if signaled
+	*/
+	bool IsSignaled();
+
+	/**
+	* blocks until the gpu has passed the fence
+	* @param timeout maximum time to wait in nanoseconds
+	* @returns true if signaled, false if the wait timed out
+	*/
+	bool Wait(uint64_t timeout = UINT64_MAX);
+
+private:
+	bool Poll(uint64_t timeout);
+
+	void* sync;
+	bool flushed = false;
+	bool signaled = false;
+};
+
+class FrameTracker
+{
+public:
+	/**
+	* tracks which frames the gpu has finished with one fence per frame
+	* @param framesInFlight maximum number of frames the cpu can be ahead of the gpu
+	*/
+	explicit FrameTracker(int framesInFlight = 2);
+
+	/**
+	* deletes the fences of the frames still in flight
+	*/
+	~FrameTracker();
+
+	/**
+	* starts recording a frame, blocks while framesInFlight frames are still being worked on by the gpu
+	*/
+	void BeginFrame();
+
+	/**
+	* fences the commands of the current frame and moves on to the next frame index
+	*/
+	void EndFrame();
+
+	/**
+	* gets the index of the frame being recorded, resources written this frame can be reused once
+	* IsFrameComplete returns true for it
+	* @returns frame index
+	*/
+	uint64_t GetFrame() const { return frame; }
+
+	/**
+	* gets the number of frames the gpu has completed without blocking, every frame index below it is done
+	* @returns completed frame count
+	*/
+	uint64_t GetCompletedFrames();
+
+	/**
+	* checks if the gpu has completed a frame without blocking
+	* @param frameIndex index returned by GetFrame
+	* @returns true if completed
+	*/
+	bool IsFrameComplete(uint64_t frameIndex) { return frameIndex < GetCompletedFrames(); }
+
+	/**
+	* gets the time the cpu was blocked in the last BeginFrame, anything above zero means gpu bound
+	* @returns seconds
+	*/
+	double GetWaitTime() const { return waitTime; }
+
+	/**
+	* gets the time the cpu was blocked in BeginFrame since the tracker was created
+	* @returns seconds
+	*/
+	double GetTotalWaitTime() const { return totalWaitTime; }
+
+	/**
+	* gets the maximum number of frames in flight
+	* @returns frame count
+	*/
+	int GetFramesInFlight() const { return framesInFlight; }
+
+private:
+	struct PendingFrame
+	{
+		uint64_t frame;
+		Fence* fence;
+	};
+
+	int framesInFlight;
+	uint64_t frame = 0;
+	uint64_t completedFrames = 0;
+	double waitTime = 0.0;
+	double totalWaitTime = 0.0;
+	std::deque<PendingFrame> pending;
+};
@@ -1,24 +1,56 @@
 #include "Framebuffer.h"
 #include "GL.h"
 
+#include <utility>
+
 Framebuffer::Framebuffer(int width, int height)
 	:id(0), width(width), height(height), depthStencilAttachment(nullptr)
 {
 }
 
 Framebuffer::~Framebuffer()
+{
+	Release();
+}
+
+Framebuffer::Framebuffer(Framebuffer&& other) noexcept
+	:id(std::exchange(other.id, 0)), width(other.width), height(other.height),
+	attachments(std::move(other.attachments)), depthStencilAttachment(std::exchange(other.depthStencilAttachment, nullptr))
+{
+	other.attachments.clear();
+}
+
+Framebuffer& Framebuffer::operator=(Framebuffer&& other) noexcept
+{
+	if (this != &other)
+	{
+		Release();
+		id = std::exchange(other.id, 0);
+		width = other.width;
+		height = other.height;
+		attachments = std::move(other.attachments);
+		other.attachments.clear();
+		depthStencilAttachment = std::exchange(other.depthStencilAttachment, nullptr);
+	}
+	return *this;
+}
+
+void Framebuffer::Release()
 {
 	glDeleteFramebuffers(1, &id);
+	id = 0;
 	for (auto &[texture, _ ]: attachments)
 		delete texture;
 	attachments.clear();
 
 	delete depthStencilAttachment;
+	depthStencilAttachment = nullptr;
 }
 
 void Framebuffer::AddAttachment(Format format, bool draw)
 {
-	attachments.push_back({ new Texture2D(width, height, format), draw });
+	auto texture = new Texture2D(width, height, format, nullptr, false, MemoryCategory::RenderTarget);
+	attachments.push_back({ texture, draw });
 }
 
 void Framebuffer::AddDepthStencil()
@@ -26,7 +58,7 @@ void Framebuffer::AddDepthStencil()
 	if (depthStencilAttachment)
 		delete depthStencilAttachment;
 
-	depthStencilAttachment = new Texture2D(width, height, Format::D24S8);
+	depthStencilAttachment = new Texture2D(width, height, Format::D24S8, nullptr, false, MemoryCategory::RenderTarget);
 }
 
 void Framebuffer::Resize(int width, int height)
@@ -18,6 +18,16 @@ public:
 	*/
 	~Framebuffer();
 
+	Framebuffer(const Framebuffer&) = delete;
+	Framebuffer& operator=(const Framebuffer&) = delete;
+
+	/**
+	* takes over the OpenGL handle and the attachments of another framebuffer, the other one is left empty and can only be destroyed or assigned to
+	* @param other framebuffer to move from
+	*/
+	Framebuffer(Framebuffer&& other) noexcept;
+	Framebuffer& operator=(Framebuffer&& other) noexcept;
+
 	/**
 	* adds an attachment to the framebuffer
 	* @param format pixel format the attachment is going to use 
@@ -108,6 +118,8 @@ public:
 	void BindColorAttachments();
 
 private:
+	void Release();
+
 	unsigned int id;
 	int width, height;
 	std::vector<std::tuple<Texture2D*, bool>> attachments;
@@ -1,5 +1,7 @@
 #include "GL.h"
 
+#include <string.h>
+
 bool InitGL()
 {
 #ifdef USE_GLEW
@@ -10,3 +12,16 @@ bool InitGL()
 	// TODO :: Add GLAD
 #endif
 }
+
+bool HasExtension(const char* name)
+{
+	int count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+	for (int i = 0; i < count; i++)
+	{
+		auto extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+		if (extension && strcmp(extension, name) == 0)
+			return true;
+	}
+	return false;
+}
@@ -13,3 +13,6 @@
 #endif
 
 bool InitGL();
+
+// checks if the driver exposes an extension, i.e "GL_KHR_parallel_shader_compile"
+bool HasExtension(const char* name);
@@ -0,0 +1,159 @@
+#include "GPUMemory.h"
+#include "GL.h"
+
+#include <stdio.h>
+
+#define GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX 0x9047
+#define GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX 0x9049
+#define GL_GPU_MEMORY_INFO_EVICTION_COUNT_NVX 0x904A
+#define GL_TEXTURE_FREE_MEMORY_ATI 0x87FC
+
+static constexpr int CategoryCount = (int)MemoryCategory::Count;
+
+struct CategoryUsage
+{
+	size_t usage = 0;
+	size_t peak = 0;
+	size_t budget = 0;
+	bool overBudget = false;
+	GPUMemory::BudgetCallback callback;
+};
+
+static CategoryUsage categories[CategoryCount];
+static size_t totalUsage = 0;
+static size_t totalPeak = 0;
+
+void GPUMemory::Allocate(MemoryCategory category, size_t bytes)
+{
+	auto& c = categories[(int)category];
+	c.usage += bytes;
+	if (c.usage > c.peak) c.peak = c.usage;
+
+	totalUsage += bytes;
+	if (totalUsage > totalPeak) totalPeak = totalUsage;
+
+	if (c.budget != 0 && c.usage > c.budget && !c.overBudget)
+	{
+		c.overBudget = true;
+		if (c.callback)
+			c.callback(category, c.usage, c.budget);
+	}
+}
+
+void GPUMemory::Free(MemoryCategory category, size_t bytes)
+{
+	auto& c = categories[(int)category];
+	c.usage -= bytes < c.usage ? bytes : c.usage;
+	totalUsage -= bytes < totalUsage ? bytes : totalUsage;
+
+	if (c.usage <= c.budget)
+		c.overBudget = false;
+}
+
+size_t GPUMemory::GetUsage(MemoryCategory category)
+{
+	return categories[(int)category].usage;
+}
+
+size_t GPUMemory::GetPeak(MemoryCategory category)
+{
+	return categories[(int)category].peak;
+}
+
+size_t GPUMemory::GetTotalUsage()
+{
+	return totalUsage;
+}
+
+size_t GPUMemory::GetTotalPeak()
+{
+	return totalPeak;
+}
+
+void GPUMemory::SetBudget(MemoryCategory category, size_t bytes, BudgetCallback callback)
+{
+	auto& c = categories[(int)category];
+	c.budget = bytes;
+	c.callback = std::move(callback);
+	c.overBudget = false;
+
+	// a budget set below the current usage is reported right away
+	if (c.budget != 0 && c.usage > c.budget)
+	{
+		c.overBudget = true;
+		if (c.callback)
+			c.callback(category, c.usage, c.budget);
+	}
+}
+
+void GPUMemory::ResetPeaks()
+{
+	for (auto& c : categories)
+		c.peak = c.usage;
+	totalPeak = totalUsage;
+}
+
+DriverMemoryInfo GPUMemory::QueryDriverMemory()
+{
+	DriverMemoryInfo info = {};
+
+	// the drivers report kilobytes
+	if (HasExtension("GL_NVX_gpu_memory_info"))
+	{
+		int dedicated = 0, available = 0, evictions = 0;
+		glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &dedicated);
+		glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &available);
+		glGetIntegerv(GL_GPU_MEMORY_INFO_EVICTION_COUNT_NVX, &evictions);
+
+		info.available = true;
+		info.dedicated = (size_t)dedicated * 1024;
+		info.currentAvailable = (size_t)available * 1024;
+		info.evictionCount = (size_t)evictions;
+	}
+	else if (HasExtension("GL_ATI_meminfo"))
+	{
+		// total free, largest free block, total free auxiliary, largest free auxiliary block
+		int free[4] = {};
+		glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, free);
+
+		info.available = true;
+		info.currentAvailable = (size_t)free[0] * 1024;
+	}
+
+	return info;
+}
+
+const char* GPUMemory::GetCategoryName(MemoryCategory category)
+{
+	switch (category)
+	{
+	case MemoryCategory::Vertex: return "Vertex";
+	case MemoryCategory::Uniform: return "Uniform";
+	case MemoryCategory::Storage: return "Storage";
+	case MemoryCategory::Texture: return "Texture";
+	case MemoryCategory::RenderTarget: return "RenderTarget";
+	case MemoryCategory::Staging: return "Staging";
+	case MemoryCategory::Other: return "Other";
+	default: return "Unknown";
+	}
+}
+
+void GPUMemory::PrintReport()
+{
+	constexpr double MB = 1024.0 * 1024.0;
+
+	printf("%-14s %10s %10s %10s\n", "Category", "Usage MB", "Peak MB", "Budget MB");
+	for (int i = 0; i < CategoryCount; i++)
+	{
+		const auto& c = categories[i];
+		printf("%-14s %10.2f %10.2f %10.2f\n", GetCategoryName((MemoryCategory)i), c.usage / MB, c.peak / MB, c.budget / MB);
+	}
+	printf("%-14s %10.2f %10.2f\n", "Total", totalUsage / MB, totalPeak / MB);
+
+	auto driver = QueryDriverMemory();
+	if (driver.available)
+	{
+		printf("Driver: %.2f MB available of %.2f MB dedicated, %zu evictions\n",
+			driver.currentAvailable / MB, driver.dedicated / MB, driver.evictionCount);
+	}
+}
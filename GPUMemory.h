@@ -0,0 +1,115 @@
+#pragma once
+#include <stddef.h>
+#include <functional>
+
+enum class MemoryCategory
+{
+	Vertex,
+	Uniform,
+	Storage,
+	Texture,
+	RenderTarget,
+	Staging,
+	Other,
+	Count,
+};
+
+/**
+* memory info reported by the driver (GL_NVX_gpu_memory_info or GL_ATI_meminfo), sizes are in bytes
+*/
+struct DriverMemoryInfo
+{
+	// false if neither extension is supported, everything else is 0 then
+	bool available;
+	// total dedicated video memory (0 if the driver does not report it)
+	size_t dedicated;
+	// video memory currently available
+	size_t currentAvailable;
+	// number of evictions since the context was created (0 if the driver does not report it)
+	size_t evictionCount;
+};
+
+/**
+* global registry of the gpu memory allocated by JinGL objects. buffers, textures and framebuffer attachments
+* register themselves on creation and unregister on destruction. the sizes are what was requested from the
+* driver, the driver may round or pad them. not thread safe, only use it on the render thread
+*/
+class GPUMemory
+{
+public:
+	/**
+	* called when the usage of a category goes above its budget (once every time it crosses it)
+	*/
+	using BudgetCallback = std::function<void(MemoryCategory category, size_t usage, size_t budget)>;
+
+	/**
+	* records an allocation
+	* @param category category of the allocation
+	* @param bytes size in bytes
+	*/
+	static void Allocate(MemoryCategory category, size_t bytes);
+
+	/**
+	* records a deallocation
+	* @param category category of the allocation
+	* @param bytes size in bytes
+	*/
+	static void Free(MemoryCategory category, size_t bytes);
+
+	/**
+	* gets the bytes currently allocated in a category
+	* @param category category
+	* @returns bytes
+	*/
+	static size_t GetUsage(MemoryCategory category);
+
+	/**
+	* gets the highest usage a category has reached
+	* @param category category
+	* @returns bytes
+	*/
+	static size_t GetPeak(MemoryCategory category);
+
+	/**
+	* gets the bytes currently allocated in all the categories
+	* @returns bytes
+	*/
+	static size_t GetTotalUsage();
+
+	/**
+	* gets the highest total usage reached
+	* @returns bytes
+	*/
+	static size_t GetTotalPeak();
+
+	/**
+	* sets a soft budget for a category, nothing is refused when it is exceeded the callback is just called
+	* @param category category
+	* @param bytes budget, 0 to remove it
+	* @param callback called when the usage goes above the budget
+	*/
+	static void SetBudget(MemoryCategory category, size_t bytes, BudgetCallback callback);
+
+	/**
+	* resets the peaks to the current usage
+	*/
+	static void ResetPeaks();
+
+	/**
+	* queries the driver for the video memory info
+	* @returns memory info
+	*/
+	static DriverMemoryInfo QueryDriverMemory();
+
+	/**
+	* gets the name of a category
+	* @param category category
+	* @returns name
+	*/
+	static const char* GetCategoryName(MemoryCategory category);
+
+	/**
+	* prints the usage, peak and budget of every category and the driver memory info
+	*/
+	static void PrintReport();
+};
@@ -2,13 +2,31 @@
 
 #include "GL.h"
 #include "Debug.h"
+#include "GPUMemory.h"
 #include "Buffer.h"
+#include "Fence.h"
+#include "BufferAllocator.h"
+#include "UniformBuffer.h"
+#include "TypedBuffer.h"
+#include "UploadManager.h"
+#include "ReadbackManager.h"
 #include "Framebuffer.h"
 #include "Shader.h"
+#include "ProgramCache.h"
+#include "ShaderCompiler.h"
+#include "ShaderPreprocessor.h"
+#include "ShaderVariantCache.h"
+#include "ComputeProgram.h"
+#include "ProgramPipeline.h"
 #include "Texture2D.h"
 #include "TextureLoader.h"
 #include "VertexInput.h"
 #include "Platform.h"
 #include "Batcher.h"
+#include "PolygonCache.h"
+#include "Tilemap.h"
+#include "ParticleSystem.h"
+#include "TextureAtlas.h"
+#include "SpriteAnimator.h"
 #include "Colors.h"
 #include "GUI.h"
\ No newline at end of file
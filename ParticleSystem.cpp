@@ -0,0 +1,351 @@
+#include "ParticleSystem.h"
+#include "GL.h"
+
+#include <numeric>
+#include <vector>
+#include <glm/gtc/type_ptr.hpp>
+
+// handles of the uniforms set every draw
+static constexpr UniformHandle ProjectionUniform = "projection"_uniform;
+static constexpr UniformHandle UseTextureUniform = "use_texture"_uniform;
+
+#pragma pack(push, 1)
+struct ParticleParams
+{
+	ParticleEmitter emitter;
+	float deltaTime;
+	uint32_t emitCount;
+	uint32_t seed;
+	uint32_t maxParticles;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(ParticleParams) == 108, "ParticleParams must match the std430 Params block");
+
+// size of the std430 Particle struct
+static constexpr size_t ParticleStride = 32;
+
+// byte offsets of the indirect arguments inside the counters buffer
+static constexpr size_t DispatchArgsOffset = 16;
+static constexpr size_t DrawArgsOffset = 32;
+
+static const char* particle_common_source = R"(
+	struct Particle
+	{
+		vec2 position;
+		vec2 velocity;
+		float age;
+		float lifetime;
+		vec2 padding;
+	};
+
+	layout(std430, binding = 0) buffer Particles { Particle particles[]; };
+	layout(std430, binding = 1) buffer AliveCurrent { uint alive_current[]; };
+	layout(std430, binding = 2) buffer AliveNext { uint alive_next[]; };
+	layout(std430, binding = 3) buffer Dead { uint dead[]; };
+
+	layout(std430, binding = 4) buffer Counters
+	{
+		uint alive_count;
+		uint next_alive_count;
+		int dead_count;
+		uint counters_padding;
+		uint dispatch_x;
+		uint dispatch_y;
+		uint dispatch_z;
+		uint dispatch_padding;
+		uint draw_count;
+		uint draw_instance_count;
+		uint draw_first;
+		uint draw_base_instance;
+	};
+
+	layout(std430, binding = 5) readonly buffer Params
+	{
+		vec4 start_color;
+		vec4 end_color;
+		vec2 emit_position;
+		vec2 position_variance;
+		vec2 emit_velocity;
+		vec2 velocity_variance;
+		vec2 gravity;
+		float lifetime;
+		float lifetime_variance;
+		float start_size;
+		float end_size;
+		float rate;
+		float delta_time;
+		uint emit_count;
+		uint seed;
+		uint max_particles;
+	};
+
+	uint hash(uint x)
+	{
+		uint state = x * 747796405u + 2891336453u;
+		uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+		return (word >> 22u) ^ word;
+	}
+
+	float random(inout uint state)
+	{
+		state = hash(state);
+		return float(state) / 4294967295.0;
+	}
+
+	vec2 random_signed2(inout uint state)
+	{
+		return vec2(random(state), random(state)) * 2.0 - 1.0;
+	}
+)";
+
+static const char* particle_emit_source = R"(
+	layout(local_size_x = 64) in;
+
+	void main()
+	{
+		uint i = gl_GlobalInvocationID.x;
+		if (i >= emit_count)
+			return;
+
+		// pop a free slot, give it back if the pool is exhausted
+		int previous = atomicAdd(dead_count, -1);
+		if (previous <= 0)
+		{
+			atomicAdd(dead_count, 1);
+			return;
+		}
+
+		uint index = dead[previous - 1];
+		uint state = hash(seed ^ i);
+
+		Particle p;
+		p.position = emit_position + random_signed2(state) * position_variance;
+		p.velocity = emit_velocity + random_signed2(state) * velocity_variance;
+		p.age = 0.0;
+		p.lifetime = max(lifetime + (random(state) * 2.0 - 1.0) * lifetime_variance, 0.0001);
+		p.padding = vec2(0.0);
+		particles[index] = p;
+
+		alive_current[atomicAdd(alive_count, 1u)] = index;
+	}
+)";
+
+static const char* particle_prepare_source = R"(
+	layout(local_size_x = 1) in;
+
+	void main()
+	{
+		dispatch_x = (alive_count + 63u) / 64u;
+		dispatch_y = 1u;
+		dispatch_z = 1u;
+		next_alive_count = 0u;
+	}
+)";
+
+static const char* particle_simulate_source = R"(
+	layout(local_size_x = 64) in;
+
+	void main()
+	{
+		uint i = gl_GlobalInvocationID.x;
+		if (i >= alive_count)
+			return;
+
+		uint index = alive_current[i];
+		Particle p = particles[index];
+
+		p.age += delta_time;
+		if (p.age >= p.lifetime)
+		{
+			dead[atomicAdd(dead_count, 1)] = index;
+			return;
+		}
+
+		p.velocity += gravity * delta_time;
+		p.position += p.velocity * delta_time;
+		particles[index] = p;
+
+		// survivors are compacted into the next alive list
+		alive_next[atomicAdd(next_alive_count, 1u)] = index;
+	}
+)";
+
+static const char* particle_finalize_source = R"(
+	layout(local_size_x = 1) in;
+
+	void main()
+	{
+		alive_count = next_alive_count;
+		draw_count = 6u;
+		draw_instance_count = alive_count;
+		draw_first = 0u;
+		draw_base_instance = 0u;
+	}
+)";
+
+static const char* particle_vertex_source = R"(
+	uniform mat4 projection;
+
+	out vec4 v_color;
+	out vec2 v_uv;
+
+	const vec2 corners[6] = vec2[](
+		vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+		vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+	);
+
+	void main()
+	{
+		Particle p = particles[alive_current[gl_InstanceID]];
+		float t = clamp(p.age / p.lifetime, 0.0, 1.0);
+		vec2 corner = corners[gl_VertexID];
+		float size = mix(start_size, end_size, t);
+
+		gl_Position = projection * vec4(p.position + (corner - 0.5) * size, 0.0, 1.0);
+		v_color = mix(start_color, end_color, t);
+		v_uv = corner;
+	}
+)";
+
+static const char* particle_fragment_source = R"(
+	#version 460
+
+	uniform sampler2D particle_texture;
+	uniform int use_texture;
+
+	out vec4 frag_color;
+
+	in vec4 v_color;
+	in vec2 v_uv;
+
+	void main()
+	{
+		if (use_texture != 0)
+			frag_color = texture(particle_texture, v_uv) * v_color;
+		else
+			frag_color = v_color;
+	}
+)";
+
+static ComputeProgram* CreateComputeProgram(const char* source)
+{
+	return new ComputeProgram(std::string("#version 460\n") + particle_common_source + source);
+}
+
+ParticleSystem::ParticleSystem(uint32_t maxParticles)
+	:maxParticles(maxParticles)
+{
+	particles = new Buffer(maxParticles * ParticleStride, nullptr, false);
+	aliveLists[0] = new Buffer(maxParticles * sizeof(uint32_t), nullptr, false);
+	aliveLists[1] = new Buffer(maxParticles * sizeof(uint32_t), nullptr, false);
+
+	// every slot starts out free
+	std::vector<uint32_t> dead(maxParticles);
+	std::iota(dead.begin(), dead.end(), 0);
+	deadList = new Buffer(dead.size() * sizeof(uint32_t), dead.data(), false);
+
+	uint32_t initialCounters[12] = {
+		0, 0, maxParticles, 0,
+		0, 1, 1, 0,
+		6, 0, 0, 0
+	};
+	counters = new Buffer(sizeof(initialCounters), initialCounters, false);
+	params = new Buffer(sizeof(ParticleParams), nullptr, true);
+
+	emitProgram = CreateComputeProgram(particle_emit_source);
+	prepareProgram = CreateComputeProgram(particle_prepare_source);
+	simulateProgram = CreateComputeProgram(particle_simulate_source);
+	finalizeProgram = CreateComputeProgram(particle_finalize_source);
+
+	auto v_shader = new Shader(ShaderType::Vertex, std::string("#version 460\n") + particle_common_source + particle_vertex_source);
+	auto f_shader = new Shader(ShaderType::Fragment, particle_fragment_source);
+	renderProgram = new ShaderProgram(v_shader, f_shader);
+	renderProgram->UniformInt("particle_texture", 0);
+
+	// particles are expanded from gl_VertexID and gl_InstanceID so there are no attributes
+	vertexInput = new VertexInput();
+}
+
+ParticleSystem::~ParticleSystem()
+{
+	delete particles;
+	delete aliveLists[0];
+	delete aliveLists[1];
+	delete deadList;
+	delete counters;
+	delete params;
+	delete vertexInput;
+	delete emitProgram;
+	delete prepareProgram;
+	delete simulateProgram;
+	delete finalizeProgram;
+	delete renderProgram;
+}
+
+void ParticleSystem::Emit(uint32_t count)
+{
+	pendingEmit += count;
+}
+
+void ParticleSystem::Update(float deltaTime)
+{
+	emitAccumulator += emitter.rate * deltaTime;
+	auto rateEmit = (uint32_t)emitAccumulator;
+	emitAccumulator -= (float)rateEmit;
+
+	uint32_t emitCount = pendingEmit + rateEmit;
+	if (emitCount > maxParticles)
+		emitCount = maxParticles;
+	pendingEmit = 0;
+
+	ParticleParams frameParams = { emitter, deltaTime, emitCount, frame * 2654435761u, maxParticles };
+	params->SubData(sizeof(frameParams), 0, &frameParams);
+
+	particles->BindAsSSBO(0);
+	aliveLists[current]->BindAsSSBO(1);
+	aliveLists[1 - current]->BindAsSSBO(2);
+	deadList->BindAsSSBO(3);
+	counters->BindAsSSBO(4);
+	params->BindAsSSBO(5);
+
+	if (emitCount > 0)
+	{
+		emitProgram->DispatchThreads(emitCount);
+		IssueBarrier(Barrier::ShaderStorage);
+	}
+
+	// prepare writes the simulate dispatch arguments
+	prepareProgram->Dispatch(1);
+	IssueBarrier(Barrier::ShaderStorage | Barrier::Command);
+
+	simulateProgram->DispatchIndirect(*counters, DispatchArgsOffset);
+	IssueBarrier(Barrier::ShaderStorage);
+
+	// finalize writes the draw arguments read by Draw
+	finalizeProgram->Dispatch(1);
+	IssueBarrier(Barrier::ShaderStorage | Barrier::Command);
+
+	// the survivors are now in the other list
+	current = 1 - current;
+	frame++;
+}
+
+void ParticleSystem::Draw(const glm::mat4& projection)
+{
+	particles->BindAsSSBO(0);
+	aliveLists[current]->BindAsSSBO(1);
+	params->BindAsSSBO(5);
+
+	vertexInput->Bind();
+	renderProgram->Bind();
+
+	glm::mat4 proj = projection;
+	renderProgram->UniformMat4(ProjectionUniform, glm::value_ptr(proj));
+	renderProgram->UniformInt(UseTextureUniform, texture != nullptr);
+	if (texture)
+		texture->Bind(0);
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, counters->GetID());
+	glDrawArraysIndirect(GL_TRIANGLES, (const void*)DrawArgsOffset);
+}
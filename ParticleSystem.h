@@ -0,0 +1,102 @@
+#pragma once
+#include "Buffer.h"
+#include "Shader.h"
+#include "ComputeProgram.h"
+#include "Texture2D.h"
+#include "VertexInput.h"
+
+#include <glm/glm.hpp>
+
+/**
+* parameters of the emitter, uploaded to the gpu once per Update
+*/
+#pragma pack(push, 1)
+struct ParticleEmitter
+{
+	glm::vec4 startColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+	glm::vec4 endColor = { 1.0f, 1.0f, 1.0f, 0.0f };
+	glm::vec2 position = { 0.0f, 0.0f };
+	glm::vec2 positionVariance = { 0.0f, 0.0f };
+	glm::vec2 velocity = { 0.0f, 0.0f };
+	glm::vec2 velocityVariance = { 0.0f, 0.0f };
+	glm::vec2 gravity = { 0.0f, 0.0f };
+	float lifetime = 1.0f;
+	float lifetimeVariance = 0.0f;
+	float startSize = 1.0f;
+	float endSize = 1.0f;
+	// particles emitted per second by Update
+	float rate = 0.0f;
+};
+#pragma pack(pop)
+
+class ParticleSystem
+{
+public:
+	/**
+	* creates the particle pool and all the compute programs, the whole particle state lives on the gpu
+	* @param maxParticles maximum number of particles alive at once
+	*/
+	explicit ParticleSystem(uint32_t maxParticles);
+
+	/**
+	* destroys all the buffers and programs
+	*/
+	~ParticleSystem();
+
+	/**
+	* queues a burst of particles to be emitted in the next Update
+	* @param count number of particles to emit
+	*/
+	void Emit(uint32_t count);
+
+	/**
+	* uploads the emitter and runs the emit, simulate and compact passes on the gpu
+	* @param deltaTime time since the last update in seconds
+	*/
+	void Update(float deltaTime);
+
+	/**
+	* draws all the alive particles with a single indirect draw
+	* @param projection projection matrix to draw with
+	*/
+	void Draw(const glm::mat4& projection);
+
+	/**
+	* sets the texture of the particles (null for plain colored quads)
+	* @param texture texture to use
+	*/
+	void SetTexture(Texture2D* texture) { this->texture = texture; }
+
+	/**
+	* gets the emitter parameters, changes are picked up at the next Update
+	* @returns emitter
+	*/
+	ParticleEmitter& GetEmitter() { return emitter; }
+
+	/**
+	* gets the maximum number of particles
+	* @returns max particles
+	*/
+	uint32_t GetMaxParticles() const { return maxParticles; }
+
+private:
+	uint32_t maxParticles;
+	uint32_t pendingEmit = 0;
+	uint32_t frame = 0;
+	float emitAccumulator = 0.0f;
+	int current = 0;
+	ParticleEmitter emitter;
+	Texture2D* texture = nullptr;
+
+	Buffer* particles;
+	Buffer* aliveLists[2];
+	Buffer* deadList;
+	Buffer* counters;
+	Buffer* params;
+	VertexInput* vertexInput;
+	ComputeProgram* emitProgram;
+	ComputeProgram* prepareProgram;
+	ComputeProgram* simulateProgram;
+	ComputeProgram* finalizeProgram;
+	ShaderProgram* renderProgram;
+};
@@ -0,0 +1,284 @@
+#include "PolygonCache.h"
+#include "GL.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <tuple>
+#include <glm/gtc/type_ptr.hpp>
+
+// handles of the uniforms set every draw
+static constexpr UniformHandle ProjectionUniform = "projection"_uniform;
+
+static float Cross(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c)
+{
+	return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+static bool PointInTriangle(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b, const glm::vec2& c)
+{
+	return Cross(a, b, p) >= 0.0f && Cross(b, c, p) >= 0.0f && Cross(c, a, p) >= 0.0f;
+}
+
+bool TessellatePolygon(const glm::vec2* points, size_t count, std::vector<uint32_t>& triangles)
+{
+	if (count < 3)
+		return false;
+
+	std::vector<uint32_t> indices(count);
+	std::iota(indices.begin(), indices.end(), 0);
+
+	// ears are only convex in counter clockwise order so flip clockwise outlines
+	float area = 0.0f;
+	for (size_t i = 0, j = count - 1; i < count; j = i++)
+		area += points[j].x * points[i].y - points[i].x * points[j].y;
+
+	if (area < 0.0f)
+		std::reverse(indices.begin(), indices.end());
+
+	size_t i = 0;
+	size_t misses = 0;
+	while (indices.size() > 3)
+	{
+		// we went around the whole outline without finding an ear
+		if (misses > indices.size())
+			return false;
+
+		const size_t n = indices.size();
+		const auto prev = indices[(i + n - 1) % n];
+		const auto cur = indices[i % n];
+		const auto next = indices[(i + 1) % n];
+
+		const auto& a = points[prev];
+		const auto& b = points[cur];
+		const auto& c = points[next];
+
+		// a vertex on the line between its neighbours adds nothing to the outline but would block every ear
+		// touching that line, drop it without a triangle
+		float corner = Cross(a, b, c);
+		if (corner == 0.0f)
+		{
+			indices.erase(indices.begin() + (i % n));
+			i = i % indices.size();
+			misses = 0;
+			continue;
+		}
+
+		bool ear = corner > 0.0f;
+
+		// only reflex vertices can be inside a convex corner
+		for (size_t j = 0; ear && j < n; j++)
+		{
+			const auto& p = points[indices[j]];
+			if (indices[j] == prev || indices[j] == cur || indices[j] == next)
+				continue;
+			if (p == a || p == b || p == c)
+				continue;
+			if (Cross(points[indices[(j + n - 1) % n]], p, points[indices[(j + 1) % n]]) > 0.0f)
+				continue;
+			if (PointInTriangle(p, a, b, c))
+				ear = false;
+		}
+
+		if (!ear)
+		{
+			i = (i + 1) % n;
+			misses++;
+			continue;
+		}
+
+		triangles.push_back(prev);
+		triangles.push_back(cur);
+		triangles.push_back(next);
+		indices.erase(indices.begin() + (i % n));
+		i = i % indices.size();
+		misses = 0;
+	}
+
+	triangles.push_back(indices[0]);
+	triangles.push_back(indices[1]);
+	triangles.push_back(indices[2]);
+	return true;
+}
+
+static uint64_t HashPoints(const glm::vec2* points, size_t count)
+{
+	// FNV-1a
+	uint64_t hash = 0xcbf29ce484222325ull;
+	auto bytes = (const unsigned char*)points;
+	for (size_t i = 0; i < count * sizeof(glm::vec2); i++)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+
+	// 0 is reserved for failed tessellation
+	return hash == 0 ? 1 : hash;
+}
+
+void PolygonCache::Init()
+{
+	vertexBuffer = new Buffer(maxVertices * sizeof(glm::vec2), nullptr, true);
+	instanceBuffer = new Buffer(maxInstances * sizeof(PolygonInstance), nullptr, true);
+	instanceData.reserve(maxInstances);
+
+	std::string v_shader_source = R"(
+		#version 460
+		layout(location = 0) in vec2 position;
+		layout(location = 1) in vec4 transform_x;
+		layout(location = 2) in vec4 transform_y;
+		layout(location = 3) in vec4 color;
+
+		uniform mat4 projection;
+
+		out vec4 v_color;
+
+		void main()
+		{
+			vec3 p = vec3(position, 1.0);
+			gl_Position = projection * vec4(dot(transform_x.xyz, p), dot(transform_y.xyz, p), 0.0, 1.0);
+			v_color = color;
+		}
+	)";
+
+	std::string f_shader_source = R"(
+		#version 460
+
+		out vec4 frag_color;
+
+		in vec4 v_color;
+
+		void main()
+		{
+			frag_color = v_color;
+		}
+	)";
+
+	auto v_shader = new Shader(ShaderType::Vertex, v_shader_source);
+	auto f_shader = new Shader(ShaderType::Fragment, f_shader_source);
+
+	shaderProgram = new ShaderProgram(v_shader, f_shader);
+
+	vertexInput = new VertexInput();
+	vertexInput->AddVec2();
+	vertexInput->NextBinding();
+	vertexInput->AddAttribute(4, GL_FLOAT, 1);
+	vertexInput->AddAttribute(4, GL_FLOAT, 2);
+	vertexInput->AddAttribute(4, GL_FLOAT, 3);
+
+	vertexInput->SetVertexBuffer(*vertexBuffer, 0, sizeof(glm::vec2), 0);
+	vertexInput->SetVertexBuffer(*instanceBuffer, 1, sizeof(PolygonInstance), 0);
+	vertexInput->SetBindingDivisor(1, 1);
+}
+
+uint64_t PolygonCache::Cache(const glm::vec2* points, size_t count)
+{
+	auto key = HashPoints(points, count);
+
+	// the points are compared so a hash collision never returns another polygon, colliding polygons take the next free key
+	for (auto it = polygons.find(key); it != polygons.end(); it = polygons.find(key))
+	{
+		const auto& cached = it->second.points;
+		if (cached.size() == count && std::equal(cached.begin(), cached.end(), points))
+			return key;
+
+		key = key + 1 == 0 ? 1 : key + 1;
+	}
+
+	std::vector<uint32_t> triangles;
+	if (!TessellatePolygon(points, count, triangles))
+	{
+		printf("Failed to tessellate polygon with %zu points\n", count);
+		return 0;
+	}
+
+	if (numVertices + triangles.size() > maxVertices)
+	{
+		printf("PolygonCache is full\n");
+		return 0;
+	}
+
+	std::vector<glm::vec2> vertices;
+	vertices.reserve(triangles.size());
+	for (auto index : triangles)
+		vertices.push_back(points[index]);
+
+	vertexBuffer->SubData(vertices.size() * sizeof(glm::vec2), numVertices * sizeof(glm::vec2), vertices.data());
+
+	polygons[key] = { std::vector<glm::vec2>(points, points + count), (int)numVertices, (int)vertices.size(), {} };
+	numVertices += vertices.size();
+	return key;
+}
+
+void PolygonCache::Draw(uint64_t key, const glm::vec2& position, const glm::vec2& scale, float rotation, const glm::vec4& color)
+{
+	auto it = polygons.find(key);
+	if (it == polygons.end())
+		return;
+
+	auto& polygon = it->second;
+	if (polygon.instances.empty())
+		queued.push_back(&polygon);
+
+	const float c = cosf(rotation);
+	const float s = sinf(rotation);
+
+	polygon.instances.push_back({
+		{ scale.x * c, -scale.y * s, position.x, 0.0f },
+		{ scale.x * s, scale.y * c, position.y, 0.0f },
+		color
+	});
+}
+
+void PolygonCache::Flush(const glm::mat4& projection)
+{
+	if (queued.empty())
+		return;
+
+	vertexInput->Bind();
+	shaderProgram->Bind();
+
+	glm::mat4 proj = projection;
+	shaderProgram->UniformMat4(ProjectionUniform, glm::value_ptr(proj));
+
+	// (polygon, first instance, instance count)
+	std::vector<std::tuple<CachedPolygon*, size_t, size_t>> draws;
+
+	auto submit = [&]()
+	{
+		instanceBuffer->SubData(instanceData.size() * sizeof(PolygonInstance), 0, instanceData.data());
+		for (auto& [polygon, first, instances] : draws)
+		{
+			glDrawArraysInstancedBaseInstance(GL_TRIANGLES, polygon->firstVertex, polygon->vertexCount,
+				(int)instances, (unsigned int)first);
+		}
+		instanceData.clear();
+		draws.clear();
+	};
+
+	for (auto polygon : queued)
+	{
+		size_t offset = 0;
+		while (offset < polygon->instances.size())
+		{
+			if (instanceData.size() == maxInstances)
+				submit();
+
+			size_t count = std::min(polygon->instances.size() - offset, maxInstances - instanceData.size());
+			draws.push_back({ polygon, instanceData.size(), count });
+			instanceData.insert(instanceData.end(), polygon->instances.begin() + offset, polygon->instances.begin() + offset + count);
+			offset += count;
+		}
+		polygon->instances.clear();
+	}
+
+	submit();
+	queued.clear();
+}
+
+void PolygonCache::Clear()
+{
+	polygons.clear();
+	queued.clear();
+	numVertices = 0;
+}
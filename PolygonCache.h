@@ -0,0 +1,97 @@
+#pragma once
+#include "Buffer.h"
+#include "Shader.h"
+#include "VertexInput.h"
+
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+/**
+* triangulates a simple polygon (concave allowed, no holes or self intersections) by ear clipping
+* @param points outline of the polygon in either winding order
+* @param count number of points in the outline
+* @param triangles receives 3 indices into points per triangle
+* @returns false if the polygon could not be fully triangulated (degenerate or self intersecting)
+*/
+bool TessellatePolygon(const glm::vec2* points, size_t count, std::vector<uint32_t>& triangles);
+
+#pragma pack(push, 1)
+struct PolygonInstance
+{
+	glm::vec4 transformX;
+	glm::vec4 transformY;
+	glm::vec4 color;
+};
+#pragma pack(pop)
+
+class PolygonCache
+{
+public:
+	PolygonCache()
+		: vertexBuffer(0), instanceBuffer(0), vertexInput(0), shaderProgram(0)
+	{
+
+	}
+
+	~PolygonCache()
+	{
+		delete vertexBuffer;
+		delete instanceBuffer;
+		delete vertexInput;
+		delete shaderProgram;
+	}
+
+	void Init();
+
+	/**
+	* tessellates a polygon once and keeps the triangles in gpu memory. polygons with the same
+	* content share one entry so calling this every frame only costs a hash and a compare of the points
+	* @param points outline of the polygon
+	* @param count number of points in the outline
+	* @returns key of the cached polygon or 0 if it could not be tessellated or the cache is full
+	*/
+	uint64_t Cache(const glm::vec2* points, size_t count);
+
+	/**
+	* queues an instance of a cached polygon
+	* @param key key returned by Cache
+	* @param position translation applied after rotation and scale
+	* @param scale scale applied to the polygon points
+	* @param rotation rotation in radians
+	* @param color color of the instance
+	*/
+	void Draw(uint64_t key, const glm::vec2& position, const glm::vec2& scale, float rotation, const glm::vec4& color);
+
+	/**
+	* draws all the queued instances (one instanced draw call per polygon) and clears the queue
+	* @param projection projection matrix to draw with
+	*/
+	void Flush(const glm::mat4& projection);
+
+	/**
+	* forgets all the cached polygons, the keys returned by Cache are invalid after this
+	*/
+	void Clear();
+
+private:
+	struct CachedPolygon
+	{
+		// outline the entry was made from, compared on every lookup
+		std::vector<glm::vec2> points;
+		int firstVertex;
+		int vertexCount;
+		std::vector<PolygonInstance> instances;
+	};
+
+	std::unordered_map<uint64_t, CachedPolygon> polygons;
+	std::vector<CachedPolygon*> queued;
+	std::vector<PolygonInstance> instanceData;
+	size_t numVertices = 0;
+	const size_t maxVertices = 1000000;
+	const size_t maxInstances = 100000;
+	Buffer* vertexBuffer;
+	Buffer* instanceBuffer;
+	VertexInput* vertexInput;
+	ShaderProgram* shaderProgram;
+};
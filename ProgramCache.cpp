@@ -0,0 +1,169 @@
+#include "ProgramCache.h"
+#include "ShaderPreprocessor.h"
+#include "GL.h"
+
+#include <stdio.h>
+#include <filesystem>
+
+static constexpr uint32_t CacheMagic = 0x4250474A; // "JGPB"
+static constexpr uint32_t CacheVersion = 1;
+
+#pragma pack(push, 1)
+struct CacheHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t key;
+	uint32_t format;
+	uint64_t size;
+};
+#pragma pack(pop)
+
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+{
+	auto bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+static uint64_t HashString(uint64_t hash, const std::string& string)
+{
+	// the length keeps "ab" + "c" and "a" + "bc" apart
+	uint64_t length = string.size();
+	hash = HashBytes(hash, &length, sizeof(length));
+	return HashBytes(hash, string.data(), string.size());
+}
+
+ProgramCache::ProgramCache(const std::string& directory)
+	:directory(directory)
+{
+	auto vendor = (const char*)glGetString(GL_VENDOR);
+	auto renderer = (const char*)glGetString(GL_RENDERER);
+	auto version = (const char*)glGetString(GL_VERSION);
+	driver = std::string(vendor ? vendor : "") + "\n" + (renderer ? renderer : "") + "\n" + (version ? version : "");
+
+	int formats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	supported = formats > 0;
+
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+}
+
+uint64_t ProgramCache::Key(const std::vector<ShaderStageSource>& stages, const std::vector<std::string>& defines, bool separable) const
+{
+	uint64_t hash = 14695981039346656037ull;
+	hash = HashString(hash, driver);
+	hash = HashBytes(hash, &separable, sizeof(separable));
+
+	for (const auto& define : defines)
+		hash = HashString(hash, define);
+
+	for (const auto& stage : stages)
+	{
+		hash = HashBytes(hash, &stage.type, sizeof(stage.type));
+		hash = HashString(hash, stage.source);
+	}
+
+	return hash;
+}
+
+std::string ProgramCache::PathOf(uint64_t key) const
+{
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+	return (std::filesystem::path(directory) / name).string();
+}
+
+bool ProgramCache::Read(uint64_t key, std::vector<unsigned char>& binary, unsigned int& format) const
+{
+	FILE* file = nullptr;
+	fopen_s(&file, PathOf(key).c_str(), "rb");
+	if (file == nullptr)
+		return false;
+
+	fseek(file, 0, SEEK_END);
+	long fileSize = ftell(file);
+	rewind(file);
+
+	// the size is checked against the file before allocating so a corrupt header is just a miss
+	CacheHeader header = {};
+	bool valid = fileSize >= (long)sizeof(header) && fread(&header, sizeof(header), 1, file) == 1 &&
+		header.magic == CacheMagic && header.version == CacheVersion && header.key == key &&
+		header.size > 0 && header.size == (uint64_t)fileSize - sizeof(header);
+
+	if (valid)
+	{
+		binary.resize(header.size);
+		valid = fread(binary.data(), 1, binary.size(), file) == binary.size();
+		format = header.format;
+	}
+
+	fclose(file);
+	return valid;
+}
+
+void ProgramCache::Write(uint64_t key, const std::vector<unsigned char>& binary, unsigned int format) const
+{
+	// written to a temporary file first so a crash never leaves a truncated binary behind
+	auto path = PathOf(key);
+	auto temporary = path + ".tmp";
+
+	FILE* file = nullptr;
+	fopen_s(&file, temporary.c_str(), "wb");
+	if (file == nullptr)
+	{
+		printf("ProgramCache: cannot write %s\n", temporary.c_str());
+		return;
+	}
+
+	CacheHeader header = { CacheMagic, CacheVersion, key, format, binary.size() };
+	bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+		fwrite(binary.data(), 1, binary.size(), file) == binary.size();
+	fclose(file);
+
+	std::error_code error;
+	if (written)
+		std::filesystem::rename(temporary, path, error);
+	else
+		std::filesystem::remove(temporary, error);
+}
+
+ShaderProgram* ProgramCache::Load(const std::vector<ShaderStageSource>& stages, const std::vector<std::string>& defines, bool separable)
+{
+	auto program = new ShaderProgram();
+	auto key = Key(stages, defines, separable);
+	if (separable)
+		program->SetSeparable(true);
+
+	std::vector<unsigned char> binary;
+	unsigned int format = 0;
+	if (supported && Read(key, binary, format) && program->LoadBinary(binary.data(), binary.size(), format))
+	{
+		hits++;
+		return program;
+	}
+
+	// missing, corrupt or made by another driver, compile from source
+	misses++;
+	program->SetBinaryRetrievable(true);
+	for (const auto& stage : stages)
+		program->AttachShader(new Shader(stage.type, ShaderPreprocessor::InjectDefines(stage.source, defines)));
+
+	char* log = nullptr;
+	if (!program->Link(&log, nullptr))
+	{
+		printf("SHADER LINK ERROR: %s", log);
+		delete[] log;
+		return program;
+	}
+
+	if (supported && program->GetBinary(binary, format))
+		Write(key, binary, format);
+
+	return program;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "Shader.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class ProgramCache
+{
+public:
+	/**
+	* creates a cache that keeps program binaries in a directory
+	* @param directory directory to keep the binaries in (created if missing)
+	*/
+	explicit ProgramCache(const std::string& directory);
+
+	/**
+	* creates a program, loading its binary from the cache when there is a valid one for the same sources, defines
+	* and driver (vendor, renderer and version), else compiling the stages and storing the binary for next time
+	* @param stages sources of the stages
+	* @param defines names or "NAME VALUE" pairs injected as #define lines after the #version line of every stage
+	* @param separable true to make a separable program for a ProgramPipeline, i.e one binary per stage
+	* @returns the program (check IsValid), owned by the caller
+	*/
+	ShaderProgram* Load(const std::vector<ShaderStageSource>& stages, const std::vector<std::string>& defines = {}, bool separable = false);
+
+	/**
+	* gets the number of programs loaded from binaries
+	* @returns count
+	*/
+	size_t GetHits() const { return hits; }
+
+	/**
+	* gets the number of programs that had to be compiled
+	* @returns count
+	*/
+	size_t GetMisses() const { return misses; }
+
+private:
+	uint64_t Key(const std::vector<ShaderStageSource>& stages, const std::vector<std::string>& defines, bool separable) const;
+	std::string PathOf(uint64_t key) const;
+	bool Read(uint64_t key, std::vector<unsigned char>& binary, unsigned int& format) const;
+	void Write(uint64_t key, const std::vector<unsigned char>& binary, unsigned int format) const;
+
+	std::string directory;
+	std::string driver;
+	bool supported;
+	size_t hits = 0;
+	size_t misses = 0;
+};
@@ -0,0 +1,117 @@
+#include "ProgramPipeline.h"
+#include "GL.h"
+
+#include <utility>
+
+ProgramPipeline::ProgramPipeline()
+{
+	glCreateProgramPipelines(1, &id);
+}
+
+ProgramPipeline::ProgramPipeline(const ShaderProgram* vertex, const ShaderProgram* fragment)
+	:ProgramPipeline()
+{
+	UseStages(vertex, ShaderStage::Vertex);
+	UseStages(fragment, ShaderStage::Fragment);
+}
+
+ProgramPipeline::~ProgramPipeline()
+{
+	glDeleteProgramPipelines(1, &id);
+}
+
+ProgramPipeline::ProgramPipeline(ProgramPipeline&& other) noexcept
+	:id(std::exchange(other.id, 0))
+{ }
+
+ProgramPipeline& ProgramPipeline::operator=(ProgramPipeline&& other) noexcept
+{
+	if (this != &other)
+	{
+		glDeleteProgramPipelines(1, &id);
+		id = std::exchange(other.id, 0);
+	}
+	return *this;
+}
+
+void ProgramPipeline::UseStages(const ShaderProgram* program, ShaderStage stages)
+{
+	glUseProgramStages(id, (unsigned int)stages, program ? program->GetID() : 0);
+}
+
+void ProgramPipeline::Bind() const
+{
+	glUseProgram(0);
+	glBindProgramPipeline(id);
+}
+
+bool ProgramPipeline::Validate(char** log) const
+{
+	glValidateProgramPipeline(id);
+
+	int status;
+	glGetProgramPipelineiv(id, GL_VALIDATE_STATUS, &status);
+	if (status != GL_TRUE && log != nullptr)
+	{
+		int infoLogLen = 0;
+		glGetProgramPipelineiv(id, GL_INFO_LOG_LENGTH, &infoLogLen);
+		(*log) = new char[infoLogLen + 1];
+		glGetProgramPipelineInfoLog(id, infoLogLen, 0, (*log));
+		(*log)[infoLogLen] = 0;
+	}
+
+	return status == GL_TRUE;
+}
+
+ShaderProgram* ProgramPipeline::CreateStage(ShaderType type, const std::string& source)
+{
+	auto program = new ShaderProgram();
+	program->SetSeparable(true);
+	program->AttachShader(new Shader(type, source));
+
+	char* log;
+	if (!program->Link(&log, nullptr))
+	{
+		printf("SHADER LINK ERROR: %s", log);
+		delete[] log;
+	}
+
+	return program;
+}
+
+ProgramPipelineCache::~ProgramPipelineCache()
+{
+	for (auto& [key, entry] : pipelines)
+		delete entry.pipeline;
+	pipelines.clear();
+}
+
+ProgramPipeline* ProgramPipelineCache::Get(const ShaderProgram* vertex, const ShaderProgram* fragment)
+{
+	// program ids are unique while the programs live, Forget drops the entries before an id can be reused
+	uint64_t key = ((uint64_t)vertex->GetID() << 32) | fragment->GetID();
+
+	auto found = pipelines.find(key);
+	if (found != pipelines.end())
+		return found->second.pipeline;
+
+	auto pipeline = new ProgramPipeline(vertex, fragment);
+	pipelines[key] = { vertex, fragment, pipeline };
+	return pipeline;
+}
+
+void ProgramPipelineCache::Forget(const ShaderProgram* program)
+{
+	for (auto it = pipelines.begin(); it != pipelines.end();)
+	{
+		if (it->second.vertex == program || it->second.fragment == program)
+		{
+			delete it->second.pipeline;
+			it = pipelines.erase(it);
+		}
+		else
+		{
+			it++;
+		}
+	}
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include "Shader.h"
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+
+/**
+* stages of a pipeline (values match GL_*_SHADER_BIT passed to glUseProgramStages)
+*/
+enum class ShaderStage : unsigned int
+{
+	Vertex = 0x00000001,
+	Fragment = 0x00000002,
+	Geometry = 0x00000004,
+	TessControl = 0x00000008,
+	TessEvaluation = 0x00000010,
+	Compute = 0x00000020,
+	All = 0xFFFFFFFF,
+};
+
+constexpr ShaderStage operator|(ShaderStage a, ShaderStage b) { return ShaderStage((unsigned int)a | (unsigned int)b); }
+
+class ProgramPipeline
+{
+public:
+	/**
+	* creates an empty pipeline, stages are taken from separable programs with UseStages
+	*/
+	explicit ProgramPipeline();
+
+	/**
+	* creates a pipeline with the vertex stage of one separable program and the fragment stage of another
+	* @param vertex separable program with a vertex shader
+	* @param fragment separable program with a fragment shader
+	*/
+	explicit ProgramPipeline(const ShaderProgram* vertex, const ShaderProgram* fragment);
+
+	/**
+	* destroys the underlying OpenGL handle (not the programs)
+	*/
+	~ProgramPipeline();
+
+	ProgramPipeline(const ProgramPipeline&) = delete;
+	ProgramPipeline& operator=(const ProgramPipeline&) = delete;
+
+	/**
+	* takes over the OpenGL handle of another pipeline, the other one is left empty
+	* @param other pipeline to move from
+	*/
+	ProgramPipeline(ProgramPipeline&& other) noexcept;
+	ProgramPipeline& operator=(ProgramPipeline&& other) noexcept;
+
+	/**
+	* uses stages of a separable program in the pipeline, no relinking happens
+	* @param program separable program (null to clear the stages)
+	* @param stages stages to take from the program
+	*/
+	void UseStages(const ShaderProgram* program, ShaderStage stages);
+
+	/**
+	* binds the pipeline, any program bound with ShaderProgram::Bind is unbound since it would take precedence
+	*/
+	void Bind() const;
+
+	/**
+	* checks if the stages fit together (i.e the outputs of the vertex stage match the inputs of the fragment stage)
+	* @param log pointer to a buffer where the log is stored in if not valid (free with delete[] log after use)
+	* @returns true if the pipeline can be drawn with
+	*/
+	bool Validate(char** log = nullptr) const;
+
+	/**
+	* gets the id of underlying OpenGL handle
+	* @returns id
+	*/
+	unsigned int GetID() const { return id; }
+
+	/**
+	* creates a separable program with a single stage, compile every stage once and combine them with pipelines
+	* @param type type of the stage
+	* @param source glsl source of the stage
+	* @returns the program (check IsValid), owned by the caller
+	*/
+	static ShaderProgram* CreateStage(ShaderType type, const std::string& source);
+
+private:
+	unsigned int id;
+};
+
+class ProgramPipelineCache
+{
+public:
+	/**
+	* destroys all the pipelines (not the programs)
+	*/
+	~ProgramPipelineCache();
+
+	/**
+	* gets the pipeline combining a vertex and a fragment stage, creating it on first use.
+	* N vertex and M fragment stages need N + M links and at most N * M cheap pipeline objects
+	* @param vertex separable program with a vertex shader
+	* @param fragment separable program with a fragment shader
+	* @returns pipeline owned by the cache
+	*/
+	ProgramPipeline* Get(const ShaderProgram* vertex, const ShaderProgram* fragment);
+
+	/**
+	* destroys every pipeline that uses a program, call it before deleting the program
+	* @param program program about to be deleted
+	*/
+	void Forget(const ShaderProgram* program);
+
+	/**
+	* gets the number of pipelines
+	* @returns count
+	*/
+	size_t GetCount() const { return pipelines.size(); }
+
+private:
+	struct Entry
+	{
+		const ShaderProgram* vertex;
+		const ShaderProgram* fragment;
+		ProgramPipeline* pipeline;
+	};
+
+	std::unordered_map<uint64_t, Entry> pipelines;
+};
@@ -0,0 +1,149 @@
+#include "ReadbackManager.h"
+#include "GL.h"
+
+#include <stdio.h>
+#include <bit>
+#include <memory>
+#include <tuple>
+
+ReadbackManager::ReadbackManager()
+{
+
+}
+
+ReadbackManager::~ReadbackManager()
+{
+	pending.clear();
+	freeBuffers.clear();
+}
+
+Buffer ReadbackManager::AcquireBuffer(size_t size)
+{
+	// the smallest free buffer that fits is reused
+	int best = -1;
+	for (int i = 0; i < (int)freeBuffers.size(); i++)
+	{
+		if (freeBuffers[i].GetSize() < size)
+			continue;
+
+		if (best == -1 || freeBuffers[i].GetSize() < freeBuffers[best].GetSize())
+			best = i;
+	}
+
+	if (best == -1)
+		return Buffer(std::bit_ceil(size), nullptr, BufferStorage::MapRead | BufferStorage::ClientStorage, MemoryCategory::Staging);
+
+	Buffer buffer = std::move(freeBuffers[best]);
+	freeBuffers[best] = std::move(freeBuffers.back());
+	freeBuffers.pop_back();
+	return buffer;
+}
+
+ReadbackManager::Callback ReadbackManager::MakePromise(std::future<std::vector<unsigned char>>& future)
+{
+	auto promise = std::make_shared<std::promise<std::vector<unsigned char>>>();
+	future = promise->get_future();
+
+	return [promise](const void* data, size_t size) {
+		auto bytes = (const unsigned char*)data;
+		promise->set_value(std::vector<unsigned char>(bytes, bytes + size));
+	};
+}
+
+void ReadbackManager::ReadBuffer(const Buffer& source, size_t offset, size_t size, Callback callback)
+{
+	if (size == 0)
+		return;
+
+	Buffer buffer = AcquireBuffer(size);
+	source.CopyTo(buffer, offset, 0, size);
+
+	pending.push_back({ std::move(buffer), size, Fence(), std::move(callback) });
+}
+
+std::future<std::vector<unsigned char>> ReadbackManager::ReadBuffer(const Buffer& source, size_t offset, size_t size)
+{
+	std::future<std::vector<unsigned char>> future;
+	ReadBuffer(source, offset, size, MakePromise(future));
+	return future;
+}
+
+void ReadbackManager::ReadFramebuffer(const Framebuffer* framebuffer, int attachment, int x, int y, int width, int height, Callback callback)
+{
+	auto format = Format::RGBA8;
+	if (framebuffer != nullptr)
+	{
+		const auto& attachments = framebuffer->GetColorAttachments();
+		if (attachment < 0 || attachment >= (int)attachments.size())
+		{
+			printf("ReadbackManager: framebuffer %u has no color attachment %d\n", framebuffer->GetID(), attachment);
+			return;
+		}
+
+		format = std::get<0>(attachments[attachment])->GetFormat();
+	}
+
+	size_t size = (size_t)width * height * Texture2D::GetBytesPerPixel(format);
+	if (size == 0)
+		return;
+
+	Buffer buffer = AcquireBuffer(size);
+
+	int previousFramebuffer = 0;
+	int previousPackBuffer = 0;
+	int packAlignment = 4;
+	glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousFramebuffer);
+	glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &previousPackBuffer);
+	glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+
+	// the read buffer is framebuffer state, it can only be queried through the read framebuffer binding
+	unsigned int id = framebuffer ? framebuffer->GetID() : 0;
+	int previousReadBuffer = GL_NONE;
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, id);
+	glGetIntegerv(GL_READ_BUFFER, &previousReadBuffer);
+
+	glNamedFramebufferReadBuffer(id, framebuffer ? GL_COLOR_ATTACHMENT0 + attachment : GL_BACK);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.GetID());
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+	// with a pack buffer bound glReadPixels only queues the copy instead of waiting for the frame
+	glReadPixels(x, y, width, height, Texture2D::GetPixelFormat(format), Texture2D::GetPixelType(format), nullptr);
+
+	glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+	glNamedFramebufferReadBuffer(id, previousReadBuffer);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, previousPackBuffer);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, previousFramebuffer);
+
+	pending.push_back({ std::move(buffer), size, Fence(), std::move(callback) });
+}
+
+std::future<std::vector<unsigned char>> ReadbackManager::ReadFramebuffer(const Framebuffer* framebuffer, int attachment, int x, int y, int width, int height)
+{
+	std::future<std::vector<unsigned char>> future;
+	ReadFramebuffer(framebuffer, attachment, x, y, width, height, MakePromise(future));
+	return future;
+}
+
+void ReadbackManager::Update()
+{
+	// fences signal in order so only the oldest readbacks need checking
+	while (!pending.empty() && pending.front().fence.IsSignaled())
+	{
+		auto& readback = pending.front();
+
+		auto data = readback.buffer.MapRange(0, readback.size, BufferMap::Read);
+		if (data != nullptr)
+		{
+			readback.callback(data, readback.size);
+			readback.buffer.Unmap();
+		}
+		else
+		{
+			printf("ReadbackManager: failed to map readback buffer\n");
+			readback.callback(nullptr, 0);
+		}
+
+		freeBuffers.push_back(std::move(readback.buffer));
+		pending.pop_front();
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include "Buffer.h"
+#include "Fence.h"
+#include "Framebuffer.h"
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <vector>
+
+class ReadbackManager
+{
+public:
+	/**
+	* called with the read back data once the gpu has produced it, the pointer is only valid during the call
+	* (data is null and size 0 if the readback buffer could not be mapped)
+	*/
+	using Callback = std::function<void(const void* data, size_t size)>;
+
+	/**
+	* creates the readback manager, readback buffers are created on demand and reused
+	*/
+	explicit ReadbackManager();
+
+	/**
+	* destroys all the readback buffers, callbacks of pending readbacks are never called
+	*/
+	~ReadbackManager();
+
+	/**
+	* queues a copy of a range of a buffer into a readback buffer without waiting for the gpu
+	* @param source buffer to read from
+	* @param offset offset of the range
+	* @param size size of the range in bytes
+	* @param callback called from Update once the data is available
+	*/
+	void ReadBuffer(const Buffer& source, size_t offset, size_t size, Callback callback);
+
+	/**
+	* queues a copy of a range of a buffer into a readback buffer without waiting for the gpu
+	* @param source buffer to read from
+	* @param offset offset of the range
+	* @param size size of the range in bytes
+	* @returns future that is ready after the Update that sees the copy finished (do not wait on it
+	*	on the thread that calls Update)
+	*/
+	std::future<std::vector<unsigned char>> ReadBuffer(const Buffer& source, size_t offset, size_t size);
+
+	/**
+	* queues a copy of a region of a color attachment into a readback buffer without waiting for the gpu.
+	* the pixels are tightly packed in the upload format of the attachment (see Texture2D::GetPixelFormat)
+	* @param framebuffer framebuffer to read from, null for the default framebuffer (read as RGBA8 from the back buffer)
+	* @param attachment index of the color attachment
+	* @param x left of the region
+	* @param y bottom of the region
+	* @param width width of the region
+	* @param height height of the region
+	* @param callback called from Update once the data is available
+	*/
+	void ReadFramebuffer(const Framebuffer* framebuffer, int attachment, int x, int y, int width, int height, Callback callback);
+
+	/**
+	* same as ReadFramebuffer with a callback but returns a future
+	* @returns future that is ready after the Update that sees the copy finished (do not wait on it
+	*	on the thread that calls Update)
+	*/
+	std::future<std::vector<unsigned char>> ReadFramebuffer(const Framebuffer* framebuffer, int attachment, int x, int y, int width, int height);
+
+	/**
+	* checks the pending readbacks without blocking and delivers the ones the gpu has finished.
+	* call once per frame on the render thread
+	*/
+	void Update();
+
+	/**
+	* gets the number of readbacks still waiting for the gpu
+	* @returns count
+	*/
+	size_t GetPendingCount() const { return pending.size(); }
+
+private:
+	struct Readback
+	{
+		Buffer buffer;
+		size_t size;
+		Fence fence;
+		Callback callback;
+	};
+
+	Buffer AcquireBuffer(size_t size);
+	static Callback MakePromise(std::future<std::vector<unsigned char>>& future);
+
+	std::deque<Readback> pending;
+	// finished readback buffers kept around for the next readbacks
+	std::vector<Buffer> freeBuffers;
+};
@@ -1,6 +1,10 @@
 #include "Shader.h"
 #include "GL.h"
 
+#include <string.h>
+#include <algorithm>
+#include <utility>
+
 ShaderProgram::ShaderProgram()
 {
 	id = glCreateProgram();
@@ -26,6 +30,33 @@ ShaderProgram::~ShaderProgram()
 	attributes.clear();
 }
 
+ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept
+	:id(std::exchange(other.id, 0)), uniforms(std::move(other.uniforms)), attributes(std::move(other.attributes)),
+	uniformBlocks(std::move(other.uniformBlocks)), storageBlocks(std::move(other.storageBlocks)), attachedShaders(std::move(other.attachedShaders)), isValid(std::exchange(other.isValid, false)),
+	uniformTable(std::move(other.uniformTable)), uniformShadow(std::move(other.uniformShadow)),
+	issuedUniforms(other.issuedUniforms), skippedUniforms(other.skippedUniforms)
+{ }
+
+ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept
+{
+	if (this != &other)
+	{
+		glDeleteProgram(id);
+		id = std::exchange(other.id, 0);
+		uniforms = std::move(other.uniforms);
+		attributes = std::move(other.attributes);
+		uniformBlocks = std::move(other.uniformBlocks);
+		storageBlocks = std::move(other.storageBlocks);
+		attachedShaders = std::move(other.attachedShaders);
+		isValid = std::exchange(other.isValid, false);
+		uniformTable = std::move(other.uniformTable);
+		uniformShadow = std::move(other.uniformShadow);
+		issuedUniforms = other.issuedUniforms;
+		skippedUniforms = other.skippedUniforms;
+	}
+	return *this;
+}
+
 void ShaderProgram::AttachShader(Shader* shader) 
 {
 	for (size_t i = 0; i < attachedShaders.size(); ++i)
@@ -47,7 +78,23 @@ void ShaderProgram::AttachShader(Shader* shader)
 bool ShaderProgram::Link(char** log, size_t* size)
 {
 	glLinkProgram(id);
+	return FinishLink(log, size);
+}
+
+void ShaderProgram::LinkAsync()
+{
+	glLinkProgram(id);
+}
 
+bool ShaderProgram::IsLinkComplete() const
+{
+	int complete = GL_FALSE;
+	glGetProgramiv(id, GL_COMPLETION_STATUS_KHR, &complete);
+	return complete == GL_TRUE;
+}
+
+bool ShaderProgram::FinishLink(char** log, size_t* size)
+{
 	int status;
 	glGetProgramiv(id, GL_LINK_STATUS, &status);
 	if (status != GL_TRUE)
@@ -69,6 +116,49 @@ bool ShaderProgram::Link(char** log, size_t* size)
 
 	GetUniformsInfo();
 	GetAttributesInfo();
+	GetBlocksInfo();
+	return true;
+}
+
+void ShaderProgram::SetSeparable(bool separable)
+{
+	glProgramParameteri(id, GL_PROGRAM_SEPARABLE, separable ? GL_TRUE : GL_FALSE);
+}
+
+void ShaderProgram::SetBinaryRetrievable(bool retrievable)
+{
+	glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, retrievable ? GL_TRUE : GL_FALSE);
+}
+
+bool ShaderProgram::GetBinary(std::vector<unsigned char>& data, unsigned int& format) const
+{
+	if (!isValid)
+		return false;
+
+	int length = 0;
+	glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return false;
+
+	data.resize(length);
+	glGetProgramBinary(id, length, &length, &format, data.data());
+	data.resize(length);
+	return length > 0;
+}
+
+bool ShaderProgram::LoadBinary(const void* data, size_t size, unsigned int format)
+{
+	glProgramBinary(id, format, data, (int)size);
+
+	int status;
+	glGetProgramiv(id, GL_LINK_STATUS, &status);
+	isValid = status == GL_TRUE;
+	if (!isValid)
+		return false;
+
+	GetUniformsInfo();
+	GetAttributesInfo();
+	GetBlocksInfo();
 	return true;
 }
 
@@ -96,6 +186,8 @@ void ShaderProgram::GetUniformsInfo()
 
 			uniforms.push_back(uniform);
 		}
+
+		BuildUniformTable();
 	}
 }
 
@@ -126,6 +218,114 @@ void ShaderProgram::GetAttributesInfo()
 	}
 }
 
+// reads the blocks of one interface, GL_UNIFORM_BLOCK with GL_UNIFORM members or GL_SHADER_STORAGE_BLOCK with GL_BUFFER_VARIABLE members
+static void GetBlocks(unsigned int program, unsigned int blockInterface, unsigned int memberInterface, std::vector<ShaderBlock>& blocks)
+{
+	blocks.clear();
+	int count = 0;
+	glGetProgramInterfaceiv(program, blockInterface, GL_ACTIVE_RESOURCES, &count);
+
+	for (int i = 0; i < count; ++i)
+	{
+		char name[255];
+		glGetProgramResourceName(program, blockInterface, i, 255, 0, name);
+
+		const unsigned int blockProperties[] = { GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE, GL_NUM_ACTIVE_VARIABLES };
+		int blockValues[3] = {};
+		glGetProgramResourceiv(program, blockInterface, i, 3, blockProperties, 3, 0, blockValues);
+
+		ShaderBlock block = {
+			.name = std::string(name),
+			.index = i,
+			.binding = blockValues[0],
+			.size = blockValues[1],
+			.members = {}
+		};
+
+		std::vector<int> variables(blockValues[2]);
+		if (!variables.empty())
+		{
+			const unsigned int activeVariables = GL_ACTIVE_VARIABLES;
+			glGetProgramResourceiv(program, blockInterface, i, 1, &activeVariables, (int)variables.size(), 0, variables.data());
+		}
+
+		bool storage = memberInterface == GL_BUFFER_VARIABLE;
+		for (auto variable : variables)
+		{
+			glGetProgramResourceName(program, memberInterface, variable, 255, 0, name);
+
+			const unsigned int memberProperties[] = { GL_TYPE, GL_OFFSET, GL_ARRAY_SIZE, GL_ARRAY_STRIDE, GL_MATRIX_STRIDE, GL_TOP_LEVEL_ARRAY_STRIDE };
+			int memberValues[6] = {};
+			glGetProgramResourceiv(program, memberInterface, variable, storage ? 6 : 5, memberProperties, 6, 0, memberValues);
+
+			block.members.push_back({
+				.name = std::string(name),
+				.type = (unsigned int)memberValues[0],
+				.offset = memberValues[1],
+				.arraySize = memberValues[2],
+				.arrayStride = memberValues[3],
+				.matrixStride = memberValues[4],
+				.topLevelArrayStride = memberValues[5]
+			});
+		}
+
+		std::sort(block.members.begin(), block.members.end(),
+			[](const ShaderBlockMember& a, const ShaderBlockMember& b) { return a.offset < b.offset; });
+		blocks.push_back(std::move(block));
+	}
+}
+
+void ShaderProgram::GetBlocksInfo()
+{
+	if (isValid)
+	{
+		GetBlocks(id, GL_UNIFORM_BLOCK, GL_UNIFORM, uniformBlocks);
+		GetBlocks(id, GL_SHADER_STORAGE_BLOCK, GL_BUFFER_VARIABLE, storageBlocks);
+	}
+}
+
+static const ShaderBlock* FindBlock(const std::vector<ShaderBlock>& blocks, const char* name)
+{
+	for (const auto& block : blocks)
+	{
+		if (block.name == name)
+			return &block;
+	}
+	return nullptr;
+}
+
+const ShaderBlock* ShaderProgram::GetUniformBlock(const char* name) const
+{
+	return FindBlock(uniformBlocks, name);
+}
+
+const ShaderBlock* ShaderProgram::GetStorageBlock(const char* name) const
+{
+	return FindBlock(storageBlocks, name);
+}
+
+bool ShaderProgram::SetUniformBlockBinding(const char* name, int binding)
+{
+	auto block = const_cast<ShaderBlock*>(FindBlock(uniformBlocks, name));
+	if (block == nullptr)
+		return false;
+
+	glUniformBlockBinding(id, block->index, binding);
+	block->binding = binding;
+	return true;
+}
+
+bool ShaderProgram::SetStorageBlockBinding(const char* name, int binding)
+{
+	auto block = const_cast<ShaderBlock*>(FindBlock(storageBlocks, name));
+	if (block == nullptr)
+		return false;
+
+	glShaderStorageBlockBinding(id, block->index, binding);
+	block->binding = binding;
+	return true;
+}
+
 void ShaderProgram::Bind() const
 {
 	glUseProgram(id);
@@ -133,170 +333,371 @@ void ShaderProgram::Bind() const
 
 int ShaderProgram::GetUniformLocation(const char* name) const
 {
-	for (const auto& uniform : uniforms) {
-		if (uniform.name == std::string(name))
-		{
-			return uniform.location;
-		}
+	return GetUniformLocation(UniformHandle(name));
+}
+
+int ShaderProgram::GetUniformLocation(UniformHandle handle) const
+{
+	auto slot = FindUniform(handle);
+	return slot ? slot->location : -1;
+}
+
+const ShaderProgram::UniformSlot* ShaderProgram::FindUniform(UniformHandle handle) const
+{
+	if (uniformTable.empty())
+		return nullptr;
+
+	// linear probing, the table always has empty slots so the loop ends
+	uint32_t mask = (uint32_t)uniformTable.size() - 1;
+	for (uint32_t i = handle.hash & mask;; i = (i + 1) & mask)
+	{
+		const auto& slot = uniformTable[i];
+		if (slot.location == -1)
+			return nullptr;
+		if (slot.hash == handle.hash && slot.name == handle.name)
+			return &slot;
+	}
+}
+
+bool ShaderProgram::UpdateShadow(UniformHandle handle, const void* value, size_t size, int& location) const
+{
+	auto slot = FindUniform(handle);
+	if (slot == nullptr)
+		return false;
+
+	location = slot->location;
+
+	// writes bigger than the shadow copy (e.g. a 64 bit handle into a sampler) are never cached
+	if (size > slot->shadowSize)
+	{
+		issuedUniforms++;
+		totalIssuedUniforms++;
+		return true;
+	}
+
+	// the first byte tells if the shadow holds a value yet
+	auto shadowed = uniformShadow.data() + slot->shadowOffset;
+	if (shadowed[0] != 0 && memcmp(shadowed + 1, value, size) == 0)
+	{
+		skippedUniforms++;
+		totalSkippedUniforms++;
+		return false;
 	}
 
-	return -1;
+	shadowed[0] = 1;
+	memcpy(shadowed + 1, value, size);
+	issuedUniforms++;
+	totalIssuedUniforms++;
+	return true;
+}
+
+void ShaderProgram::InvalidateUniformShadow()
+{
+	std::fill(uniformShadow.begin(), uniformShadow.end(), (unsigned char)0);
+}
+
+static size_t GetUniformTypeSize(unsigned int type)
+{
+	switch (type)
+	{
+	case GL_FLOAT: case GL_INT: case GL_UNSIGNED_INT: case GL_BOOL: return 4;
+	case GL_FLOAT_VEC2: case GL_INT_VEC2: case GL_UNSIGNED_INT_VEC2: case GL_BOOL_VEC2: return 8;
+	case GL_FLOAT_VEC3: case GL_INT_VEC3: case GL_UNSIGNED_INT_VEC3: case GL_BOOL_VEC3: return 12;
+	case GL_FLOAT_VEC4: case GL_INT_VEC4: case GL_UNSIGNED_INT_VEC4: case GL_BOOL_VEC4: return 16;
+	case GL_FLOAT_MAT2: return 16;
+	case GL_FLOAT_MAT3: return 36;
+	case GL_FLOAT_MAT4: return 64;
+	case GL_FLOAT_MAT2x3: case GL_FLOAT_MAT3x2: return 24;
+	case GL_FLOAT_MAT2x4: case GL_FLOAT_MAT4x2: return 32;
+	case GL_FLOAT_MAT3x4: case GL_FLOAT_MAT4x3: return 48;
+	case GL_DOUBLE: return 8;
+	case GL_DOUBLE_VEC2: return 16;
+	case GL_DOUBLE_VEC3: return 24;
+	case GL_DOUBLE_VEC4: return 32;
+	case GL_DOUBLE_MAT4: return 128;
+	// samplers and images are set as ints or as 64 bit bindless handles
+	default: return 8;
+	}
+}
+
+void ShaderProgram::BuildUniformTable()
+{
+	size_t capacity = 8;
+	while (capacity < uniforms.size() * 4)
+		capacity *= 2;
+
+	uniformTable.assign(capacity, { 0, {}, -1, 0, 0 });
+	uniformShadow.clear();
+	uint32_t mask = (uint32_t)capacity - 1;
+
+	// colliding names just probe further, FindUniform tells them apart by name
+	auto insert = [&](const std::string& name, int location, size_t shadowOffset, size_t shadowSize) {
+		auto hash = HashUniformName(name.c_str());
+		uint32_t i = hash & mask;
+		while (uniformTable[i].location != -1)
+			i = (i + 1) & mask;
+		uniformTable[i] = { hash, name, location, shadowOffset, shadowSize };
+	};
+
+	for (const auto& uniform : uniforms)
+	{
+		// block members have no location
+		if (uniform.location < 0)
+			continue;
+
+		// a validity byte followed by the value of every element
+		size_t shadowSize = GetUniformTypeSize((unsigned int)uniform.type) * uniform.size;
+		size_t shadowOffset = uniformShadow.size();
+		uniformShadow.resize(shadowOffset + 1 + shadowSize, 0);
+
+		insert(uniform.name, uniform.location, shadowOffset, shadowSize);
+
+		// arrays are reported as name[0], they can be set by their plain name as well
+		auto bracket = uniform.name.find('[');
+		if (bracket != std::string::npos)
+			insert(uniform.name.substr(0, bracket), uniform.location, shadowOffset, shadowSize);
+	}
 }
 
 void ShaderProgram::UniformInt(const char* name, int value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	UniformInt(UniformHandle(name), value);
+}
+
+void ShaderProgram::UniformInt64(const char* name, uint64_t value) const
+{
+	UniformInt64(UniformHandle(name), value);
+}
+
+void ShaderProgram::UniformFloat(const char* name, float value) const
+{
+	UniformFloat(UniformHandle(name), value);
+}
+
+void ShaderProgram::UniformVec2(const char* name, float* value) const
+{
+	UniformVec2(UniformHandle(name), value);
+}
+
+void ShaderProgram::UniformUVec2(const char* name, unsigned int* value) const
+{
+	UniformUVec2(UniformHandle(name), value);
+}
+
+void ShaderProgram::UniformVec3(const char* name, float* value) const
+{
+	UniformVec3(UniformHandle(name), value);
+}
+
+void ShaderProgram::UniformVec4(const char* name, float* value) const
+{
+	UniformVec4(UniformHandle(name), value);
+}
+
+void ShaderProgram::UniformMat2(const char* name, float* value) const
+{
+	UniformMat2(UniformHandle(name), value);
+}
+
+void ShaderProgram::UniformMat3(const char* name, float* value) const
+{
+	UniformMat3(UniformHandle(name), value);
+}
+
+void ShaderProgram::UniformMat4(const char* name, float* value) const
+{
+	UniformMat4(UniformHandle(name), value);
+}
+
+void ShaderProgram::UniformIntArray(const char* name, int count, int* value) const
+{
+	UniformIntArray(UniformHandle(name), count, value);
+}
+
+void ShaderProgram::UniformFloatArray(const char* name, int count, float* value) const
+{
+	UniformFloatArray(UniformHandle(name), count, value);
+}
+
+void ShaderProgram::UniformVec2Array(const char* name, int count, float* value) const
+{
+	UniformVec2Array(UniformHandle(name), count, value);
+}
+
+void ShaderProgram::UniformVec3Array(const char* name, int count, float* value) const
+{
+	UniformVec3Array(UniformHandle(name), count, value);
+}
+
+void ShaderProgram::UniformMat2Array(const char* name, int count, float* value) const
+{
+	UniformMat2Array(UniformHandle(name), count, value);
+}
+
+void ShaderProgram::UniformMat3Array(const char* name, int count, float* value) const
+{
+	UniformMat3Array(UniformHandle(name), count, value);
+}
+
+void ShaderProgram::UniformMat4Array(const char* name, int count, float* value) const
+{
+	UniformMat4Array(UniformHandle(name), count, value);
+}
+
+void ShaderProgram::UniformInt(UniformHandle handle, int value) const
+{
+	int location;
+	if (UpdateShadow(handle, &value, sizeof(int), location))
 	{
 		glProgramUniform1i(id, location, value);
 	}
 }
 
-void ShaderProgram::UniformInt64(const char* name, uint64_t value) const
+void ShaderProgram::UniformInt64(UniformHandle handle, uint64_t value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, &value, sizeof(uint64_t), location))
 	{
 		glProgramUniformHandleui64ARB(id, location, value);
 	}
 }
 
-void ShaderProgram::UniformFloat(const char* name, float value) const
+void ShaderProgram::UniformFloat(UniformHandle handle, float value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, &value, sizeof(float), location))
 	{
 		glProgramUniform1f(id, location, value);
 	}
 }
 
-void ShaderProgram::UniformVec2(const char* name, float* value) const
+void ShaderProgram::UniformVec2(UniformHandle handle, float* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(float) * 2, location))
 	{
 		glProgramUniform2fv(id, location, 1, value);
 	}
 }
 
-void ShaderProgram::UniformUVec2(const char* name, unsigned int* value) const
+void ShaderProgram::UniformUVec2(UniformHandle handle, unsigned int* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(unsigned int) * 2, location))
 	{
 		glProgramUniform2uiv(id, location, 1, (unsigned int*)value);
 	}
 }
 
-void ShaderProgram::UniformVec3(const char* name, float* value) const
+void ShaderProgram::UniformVec3(UniformHandle handle, float* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(float) * 3, location))
 	{
 		glProgramUniform3fv(id, location, 1, value);
 	}
 }
 
-void ShaderProgram::UniformVec4(const char* name, float* value) const
+void ShaderProgram::UniformVec4(UniformHandle handle, float* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(float) * 4, location))
 	{
 		glProgramUniform4fv(id, location, 1, value);
 	}
 }
 
-void ShaderProgram::UniformMat2(const char* name, float* value) const
+void ShaderProgram::UniformMat2(UniformHandle handle, float* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(float) * 4, location))
 	{
 		glProgramUniformMatrix2fv(id, location, 1, false, value);
 	}
 }
 
-void ShaderProgram::UniformMat3(const char* name, float* value) const
+void ShaderProgram::UniformMat3(UniformHandle handle, float* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(float) * 9, location))
 	{
 		glProgramUniformMatrix3fv(id, location, 1, false, value);
 	}
 }
 
-void ShaderProgram::UniformMat4(const char* name, float* value) const
+void ShaderProgram::UniformMat4(UniformHandle handle, float* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(float) * 16, location))
 	{
 		glProgramUniformMatrix4fv(id, location, 1, false, value);
 	}
 }
 
-void ShaderProgram::UniformIntArray(const char* name, int count, int* value) const
+void ShaderProgram::UniformIntArray(UniformHandle handle, int count, int* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(int) * count, location))
 	{
 		glProgramUniform1iv(id, location, count, value);
 	}
 }
 
-void ShaderProgram::UniformFloatArray(const char* name, int count, float* value) const
+void ShaderProgram::UniformFloatArray(UniformHandle handle, int count, float* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(float) * count, location))
 	{
 		glProgramUniform1fv(id, location, count, value);
 	}
 }
 
-void ShaderProgram::UniformVec2Array(const char* name, int count, float* value) const
+void ShaderProgram::UniformVec2Array(UniformHandle handle, int count, float* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(float) * 2 * count, location))
 	{
 		glProgramUniform2fv(id, location, count, value);
 	}
 }
 
-void ShaderProgram::UniformVec3Array(const char* name, int count, float* value) const
+void ShaderProgram::UniformVec3Array(UniformHandle handle, int count, float* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(float) * 3 * count, location))
 	{
 		glProgramUniform3fv(id, location, count, value);
 	}
 }
 
-void ShaderProgram::UniformMat2Array(const char* name, int count, float* value) const
+void ShaderProgram::UniformMat2Array(UniformHandle handle, int count, float* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(float) * 4 * count, location))
 	{
 		glProgramUniformMatrix2fv(id, location, count, false, value);
 	}
 }
 
-void ShaderProgram::UniformMat3Array(const char* name, int count, float* value) const
+void ShaderProgram::UniformMat3Array(UniformHandle handle, int count, float* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(float) * 9 * count, location))
 	{
 		glProgramUniformMatrix3fv(id, location, count, false, value);
 	}
 }
 
-void ShaderProgram::UniformMat4Array(const char* name, int count, float* value) const
+void ShaderProgram::UniformMat4Array(UniformHandle handle, int count, float* value) const
 {
-	auto location = GetUniformLocation(name);
-	if (location >= 0)
+	int location;
+	if (UpdateShadow(handle, value, sizeof(float) * 16 * count, location))
 	{
 		glProgramUniformMatrix4fv(id, location, count, false, value);
 	}
 }
 
-Shader::Shader(ShaderType type, const std::string& source)
+Shader::Shader(ShaderType type, const std::string& source, bool checkStatus)
 	:type(type)
 {
 	id = glCreateShader(GLenum(type));
@@ -305,6 +706,68 @@ Shader::Shader(ShaderType type, const std::string& source)
 	glShaderSource(id, 1, &src, 0);
 	glCompileShader(id);
 
+	if (checkStatus)
+		CheckStatus();
+}
+
+Shader::Shader(ShaderType type, const std::vector<uint32_t>& spirv, const std::vector<SpecializationConstant>& constants, const char* entryPoint)
+	:type(type)
+{
+	id = glCreateShader(GLenum(type));
+	glShaderBinary(1, &id, GL_SHADER_BINARY_FORMAT_SPIR_V, spirv.data(), (int)(spirv.size() * sizeof(uint32_t)));
+
+	std::vector<unsigned int> indices;
+	std::vector<unsigned int> values;
+	for (const auto& constant : constants)
+	{
+		indices.push_back(constant.id);
+		values.push_back(constant.value);
+	}
+
+	// specializing takes the place of compiling, it sets the compile status
+	glSpecializeShader(id, entryPoint, (unsigned int)constants.size(), indices.data(), values.data());
+	CheckStatus();
+}
+
+bool Shader::ReadSPIRV(const std::string& path, std::vector<uint32_t>& spirv)
+{
+	FILE* file = nullptr;
+	fopen_s(&file, path.c_str(), "rb");
+	if (file == nullptr)
+	{
+		printf("Failed to load shader %s\n", path.c_str());
+		return false;
+	}
+
+	fseek(file, 0, SEEK_END);
+	auto size = ftell(file);
+	rewind(file);
+
+	spirv.resize(size > 0 ? size / sizeof(uint32_t) : 0);
+	bool read = size > 0 && size % sizeof(uint32_t) == 0 &&
+		fread(spirv.data(), sizeof(uint32_t), spirv.size(), file) == spirv.size();
+	fclose(file);
+
+	// the magic number comes first in the byte order of the module
+	if (!read || spirv[0] != 0x07230203)
+	{
+		printf("Not a SPIR-V module %s\n", path.c_str());
+		spirv.clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool Shader::IsCompileComplete() const
+{
+	int complete = GL_FALSE;
+	glGetShaderiv(id, GL_COMPLETION_STATUS_KHR, &complete);
+	return complete == GL_TRUE;
+}
+
+bool Shader::CheckStatus() const
+{
 	int status;
 	glGetShaderiv(id, GL_COMPILE_STATUS, &status);
 	if (status != GL_TRUE)
@@ -317,10 +780,27 @@ Shader::Shader(ShaderType type, const std::string& source)
 		// TODO : add a proper console for this
 		printf("Shader Error : %s\n", log);
 		delete[] log;
+		return false;
 	}
+	return true;
 }
 
 Shader::~Shader()
 {
 	glDeleteShader(id);
 }
+
+Shader::Shader(Shader&& other) noexcept
+	:id(std::exchange(other.id, 0)), type(other.type)
+{ }
+
+Shader& Shader::operator=(Shader&& other) noexcept
+{
+	if (this != &other)
+	{
+		glDeleteShader(id);
+		id = std::exchange(other.id, 0);
+		type = other.type;
+	}
+	return *this;
+}
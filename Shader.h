@@ -1,5 +1,6 @@
 #pragma once
 #include <stdint.h>
+#include <bit>
 #include <vector>
 #include <string>
 
@@ -66,9 +67,55 @@ struct ShaderAttribute {
 	int size;
 };
 
+struct ShaderBlockMember {
+	std::string name;
+	// GL type enum of the member, i.e GL_FLOAT_VEC4
+	unsigned int type;
+	// offset from the start of the block (or of the element for members of a block holding an array of structs)
+	int offset;
+	int arraySize;
+	int arrayStride;
+	int matrixStride;
+	// stride of the top level array the member is part of (shader storage blocks only, 0 if none)
+	int topLevelArrayStride;
+};
+
+struct ShaderBlock {
+	std::string name;
+	int index;
+	int binding;
+	// minimum size of the buffer range in bytes
+	int size;
+	// sorted by offset
+	std::vector<ShaderBlockMember> members;
+};
+
 enum class ShaderType {
 	Vertex = 0x8B31,
 	Fragment = 0x8B30,
+	Compute = 0x91B9,
+};
+
+/**
+* source of one stage of a program
+*/
+struct ShaderStageSource
+{
+	ShaderType type;
+	std::string source;
+};
+
+/**
+* value of a SPIR-V specialization constant (layout(constant_id = id) const ...), 32 bit scalars only
+*/
+struct SpecializationConstant
+{
+	uint32_t id;
+	uint32_t value;
+
+	static constexpr SpecializationConstant Int(uint32_t id, int32_t value) { return { id, (uint32_t)value }; }
+	static constexpr SpecializationConstant Float(uint32_t id, float value) { return { id, std::bit_cast<uint32_t>(value) }; }
+	static constexpr SpecializationConstant Bool(uint32_t id, bool value) { return { id, value ? 1u : 0u }; }
 };
 
 class Shader 
@@ -79,31 +126,114 @@ public:
 	* creates a shader
 	* @param type type of shader to create i.e Vertex, Fragment
 	* @param source source of the shader
+	* @param checkStatus false to only issue the compile without waiting for it, check it later with CheckStatus
 	*/
-	explicit Shader(ShaderType type, const std::string& source);
+	explicit Shader(ShaderType type, const std::string& source, bool checkStatus = true);
+
+	/**
+	* creates a shader from a SPIR-V module (GL 4.6 or ARB_gl_spirv) and specializes it, nothing is parsed at load time.
+	*	SPIR-V modules usually have no uniform names, use explicit locations and bindings in them
+	* @param type type of shader to create i.e Vertex, Fragment
+	* @param spirv words of the module
+	* @param constants values of the specialization constants, the others keep their default
+	* @param entryPoint name of the entry point
+	*/
+	explicit Shader(ShaderType type, const std::vector<uint32_t>& spirv, const std::vector<SpecializationConstant>& constants = {},
+		const char* entryPoint = "main");
 	
 	/**
 	* destroys the underlying OpenGL handle
 	*/
 	~Shader();
 
+	Shader(const Shader&) = delete;
+	Shader& operator=(const Shader&) = delete;
+
+	/**
+	* takes over the OpenGL handle of another shader, the other one is left empty and can only be destroyed or assigned to.
+	*	programs keep pointers to their attached shaders so do not move a shader that is attached
+	* @param other shader to move from
+	*/
+	Shader(Shader&& other) noexcept;
+	Shader& operator=(Shader&& other) noexcept;
+
 	/**
 	* gets the id of underlying OpenGL handle
 	* @returns id
 	*/
 	unsigned int GetId() const { return id; }
 
+	/**
+	* reads a SPIR-V module from a file
+	* @param path path of the .spv file
+	* @param spirv filled with the words of the module
+	* @returns false if the file cannot be read or is not SPIR-V (the error is printed)
+	*/
+	static bool ReadSPIRV(const std::string& path, std::vector<uint32_t>& spirv);
+
 	/**
 	* gets the type of the shader
 	* @returns type
 	*/
 	ShaderType GetType() const { return type; }
 
+	/**
+	* checks if the driver is done compiling without waiting (needs KHR_parallel_shader_compile)
+	* @returns true once compiled, successfully or not
+	*/
+	bool IsCompileComplete() const;
+
+	/**
+	* waits for the compile and prints the log if it failed
+	* @returns true if the shader compiled
+	*/
+	bool CheckStatus() const;
+
 private:
 	unsigned int id;
 	ShaderType type;
 };
 
+/**
+* hashes a uniform name with 32 bit FNV-1a
+* @param name name of the uniform
+* @returns hash
+*/
+constexpr uint32_t HashUniformName(const char* name)
+{
+	uint32_t hash = 2166136261u;
+	for (; *name; name++)
+	{
+		hash ^= (uint8_t)*name;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/**
+* a uniform name hashed once (at compile time for constants and literals) and resolved to a location through
+* the hash map the program builds when it is linked. nothing is allocated and the name is only compared once
+* the hash matched, so a colliding name never resolves to another uniform. the name is not copied, it has to
+* outlive the handle (literals and constants do)
+*/
+struct UniformHandle
+{
+	uint32_t hash;
+	const char* name;
+
+	constexpr UniformHandle(const char* name)
+		:hash(HashUniformName(name)), name(name)
+	{ }
+};
+
+/**
+* makes a uniform handle from a literal: "projection"_uniform
+*/
+constexpr UniformHandle operator""_uniform(const char* name, size_t)
+{
+	return UniformHandle(name);
+}
+
 class ShaderProgram
 {
 public:
@@ -125,6 +255,16 @@ public:
 	*/
 	~ShaderProgram();
 
+	ShaderProgram(const ShaderProgram&) = delete;
+	ShaderProgram& operator=(const ShaderProgram&) = delete;
+
+	/**
+	* takes over the OpenGL handle of another program, the other one is left empty and can only be destroyed or assigned to
+	* @param other program to move from
+	*/
+	ShaderProgram(ShaderProgram&& other) noexcept;
+	ShaderProgram& operator=(ShaderProgram&& other) noexcept;
+
 	/**
 	* links the program with already attached shader. call this after attaching at least one shader
 	* @param log pointer to a buffer where the log is stored in (free with delete[] log after use)
@@ -132,6 +272,57 @@ public:
 	*/
 	bool Link(char** log, size_t* size);
 
+	/**
+	* starts linking the program without waiting for the result, with KHR_parallel_shader_compile the driver
+	* links on its own threads. poll IsLinkComplete then call FinishLink
+	*/
+	void LinkAsync();
+
+	/**
+	* checks if the driver is done linking without waiting (needs KHR_parallel_shader_compile)
+	* @returns true once linked, successfully or not
+	*/
+	bool IsLinkComplete() const;
+
+	/**
+	* waits for the link started by LinkAsync and queries the uniforms and attributes if it succeeded
+	* @param log pointer to a buffer where the log is stored in (free with delete[] log after use)
+	* @param size size is the size in bytes of log stored
+	* @returns true if the program linked
+	*/
+	bool FinishLink(char** log, size_t* size);
+
+	/**
+	* marks the program as separable so it can be used as one stage of a ProgramPipeline, call it before Link
+	* (or LoadBinary)
+	* @param separable true to make the program separable
+	*/
+	void SetSeparable(bool separable);
+
+	/**
+	* asks the driver to keep the linked binary around so GetBinary can return it, call it before Link
+	* @param retrievable true to keep the binary
+	*/
+	void SetBinaryRetrievable(bool retrievable);
+
+	/**
+	* gets the driver specific binary of the linked program (needs SetBinaryRetrievable before Link)
+	* @param data filled with the binary
+	* @param format filled with the driver specific format of the binary
+	* @returns false if the program is not linked or the driver returned no binary
+	*/
+	bool GetBinary(std::vector<unsigned char>& data, unsigned int& format) const;
+
+	/**
+	* loads a binary returned by GetBinary instead of attaching and linking shaders, the driver rejects binaries
+	* made by another driver version so always be ready to fall back to compiling
+	* @param data binary
+	* @param size size of the binary in bytes
+	* @param format format returned by GetBinary
+	* @returns true if the program is valid and its uniforms / attributes were queried
+	*/
+	bool LoadBinary(const void* data, size_t size, unsigned int format);
+
 	/**
 	* binds the program
 	*/
@@ -153,6 +344,12 @@ public:
 	*/
 	void GetAttributesInfo();
 
+	/**
+	* gets the active uniform blocks and shader storage blocks with their members from the program. it is called
+	* when the program is linked by Link
+	*/
+	void GetBlocksInfo();
+
 	/**
 	* is the program valid to be bound
 	* @return valid
@@ -171,6 +368,48 @@ public:
 	*/
 	const std::vector<ShaderAttribute>& GetAttributes() const { return attributes; }
 	
+	/**
+	* gets active uniform blocks of the program
+	* @returns blocks
+	*/
+	const std::vector<ShaderBlock>& GetUniformBlocks() const { return uniformBlocks; }
+
+	/**
+	* gets active shader storage blocks of the program
+	* @returns blocks
+	*/
+	const std::vector<ShaderBlock>& GetStorageBlocks() const { return storageBlocks; }
+
+	/**
+	* gets an active uniform block by name
+	* @param name name of the block (not of its instance)
+	* @returns block (null if the program has no such block)
+	*/
+	const ShaderBlock* GetUniformBlock(const char* name) const;
+
+	/**
+	* gets an active shader storage block by name
+	* @param name name of the block (not of its instance)
+	* @returns block (null if the program has no such block)
+	*/
+	const ShaderBlock* GetStorageBlock(const char* name) const;
+
+	/**
+	* changes the binding point of a uniform block (glUniformBlockBinding)
+	* @param name name of the block
+	* @param binding binding point
+	* @returns false if the program has no such block
+	*/
+	bool SetUniformBlockBinding(const char* name, int binding);
+
+	/**
+	* changes the binding point of a shader storage block (glShaderStorageBlockBinding)
+	* @param name name of the block
+	* @param binding binding point
+	* @returns false if the program has no such block
+	*/
+	bool SetStorageBlockBinding(const char* name, int binding);
+
 	/**
 	* gets attached shaders
 	* @returns shaders
@@ -183,6 +422,53 @@ public:
 	* @returns location
 	*/
 	int GetUniformLocation(const char* name) const;
+
+	/**
+	* gets the location of the active uniform by handle
+	* @param handle handle of the uniform
+	* @returns location (-1 if the program has no such uniform)
+	*/
+	int GetUniformLocation(UniformHandle handle) const;
+
+	/**
+	* forgets the shadow copies of the uniform values so the next write of every uniform reaches the driver.
+	* call it after setting uniforms of the program without the Uniform* setters
+	*/
+	void InvalidateUniformShadow();
+
+	/**
+	* gets the number of uniform writes sent to the driver by this program
+	* @returns count
+	*/
+	uint64_t GetIssuedUniformCount() const { return issuedUniforms; }
+
+	/**
+	* gets the number of uniform writes skipped by this program because the value did not change
+	* @returns count
+	*/
+	uint64_t GetSkippedUniformCount() const { return skippedUniforms; }
+
+	/**
+	* gets the number of uniform writes sent to the driver by all the programs
+	* @returns count
+	*/
+	static uint64_t GetTotalIssuedUniformCount() { return totalIssuedUniforms; }
+
+	/**
+	* gets the number of uniform writes skipped by all the programs
+	* @returns count
+	*/
+	static uint64_t GetTotalSkippedUniformCount() { return totalSkippedUniforms; }
+
+	/**
+	* resets the issued / skipped counters of this program
+	*/
+	void ResetUniformCounters() { issuedUniforms = skippedUniforms = 0; }
+
+	/**
+	* resets the issued / skipped counters of all the programs
+	*/
+	static void ResetTotalUniformCounters() { totalIssuedUniforms = totalSkippedUniforms = 0; }
 	
 	/**
 	* gets the id of underlying OpenGL handle
@@ -196,6 +482,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformInt(const char* name, int value) const;
+	void UniformInt(UniformHandle handle, int value) const;
 	
 	/**
 	* set the int64 uniforms value
@@ -203,6 +490,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformInt64(const char* name, uint64_t value) const;
+	void UniformInt64(UniformHandle handle, uint64_t value) const;
 
 	/**
 	* set the float uniforms value
@@ -210,6 +498,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformFloat(const char* name, float value)  const;
+	void UniformFloat(UniformHandle handle, float value) const;
 
 	/**
 	* set the vec2 uniforms value
@@ -217,8 +506,10 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformVec2(const char* name, float* value) const;
+	void UniformVec2(UniformHandle handle, float* value) const;
 
 	void UniformUVec2(const char* name, unsigned int* value) const;
+	void UniformUVec2(UniformHandle handle, unsigned int* value) const;
 
 	/**
 	* set the vec3 uniforms value
@@ -226,6 +517,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformVec3(const char* name, float* value) const;
+	void UniformVec3(UniformHandle handle, float* value) const;
 
 	/**
 	* set the vec4 uniforms value
@@ -233,6 +525,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformVec4(const char* name, float* value) const;
+	void UniformVec4(UniformHandle handle, float* value) const;
 
 	/**
 	* set the mat2 uniforms value
@@ -240,6 +533,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformMat2(const char* name, float* value) const;
+	void UniformMat2(UniformHandle handle, float* value) const;
 
 	/**
 	* set the mat3 uniforms value
@@ -247,6 +541,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformMat3(const char* name, float* value) const;
+	void UniformMat3(UniformHandle handle, float* value) const;
 
 	/**
 	* set the mat4 uniforms value
@@ -254,6 +549,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformMat4(const char* name, float* value) const;
+	void UniformMat4(UniformHandle handle, float* value) const;
 
 	/**
 	* set the int array uniforms value
@@ -262,6 +558,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformIntArray(const char* name, int count, int* value) const;
+	void UniformIntArray(UniformHandle handle, int count, int* value) const;
 
 	/**
 	* set the float array uniforms value
@@ -270,6 +567,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformFloatArray(const char* name, int count, float* value) const;
+	void UniformFloatArray(UniformHandle handle, int count, float* value) const;
 
 	/**
 	* set the vec2 array uniforms value
@@ -278,6 +576,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformVec2Array(const char* name, int count, float* value) const;
+	void UniformVec2Array(UniformHandle handle, int count, float* value) const;
 
 	/**
 	* set the vec3 array uniforms value
@@ -286,6 +585,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformVec3Array(const char* name, int count, float* value) const;
+	void UniformVec3Array(UniformHandle handle, int count, float* value) const;
 
 	/**
 	* set the mat2 array uniforms value
@@ -294,6 +594,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformMat2Array(const char* name, int count, float* value) const;
+	void UniformMat2Array(UniformHandle handle, int count, float* value) const;
 	
 	/**
 	* set the mat3 array uniforms value
@@ -302,6 +603,7 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformMat3Array(const char* name, int count, float* value) const;
+	void UniformMat3Array(UniformHandle handle, int count, float* value) const;
 
 	/**
 	* set the mat4 array uniforms value
@@ -310,11 +612,39 @@ public:
 	* @param value value of the uniform
 	*/
 	void UniformMat4Array(const char* name, int count, float* value) const;
+	void UniformMat4Array(UniformHandle handle, int count, float* value) const;
 
 private:
 	unsigned int id{ 0 };
 	std::vector<ShaderUniform> uniforms;
 	std::vector<ShaderAttribute> attributes;
+	std::vector<ShaderBlock> uniformBlocks;
+	std::vector<ShaderBlock> storageBlocks;
 	std::vector<Shader*> attachedShaders;
 	bool isValid{ false };
+
+	struct UniformSlot
+	{
+		uint32_t hash;
+		// compared on a hash match, uniforms with colliding hashes get separate probed slots
+		std::string name;
+		int location;
+		size_t shadowOffset;
+		size_t shadowSize;
+	};
+
+	void BuildUniformTable();
+	const UniformSlot* FindUniform(UniformHandle handle) const;
+	bool UpdateShadow(UniformHandle handle, const void* value, size_t size, int& location) const;
+
+	// open addressing table from name hash to location, built by GetUniformsInfo
+	std::vector<UniformSlot> uniformTable;
+
+	// last value written to every uniform so unchanged writes can be skipped
+	mutable std::vector<unsigned char> uniformShadow;
+	mutable uint64_t issuedUniforms = 0;
+	mutable uint64_t skippedUniforms = 0;
+
+	static inline uint64_t totalIssuedUniforms = 0;
+	static inline uint64_t totalSkippedUniforms = 0;
 };
\ No newline at end of file
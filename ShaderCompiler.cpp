@@ -0,0 +1,95 @@
+#include "ShaderCompiler.h"
+#include "GL.h"
+
+#include <memory>
+
+ShaderCompiler::ShaderCompiler(unsigned int threads)
+{
+	if (HasExtension("GL_KHR_parallel_shader_compile"))
+	{
+		glMaxShaderCompilerThreadsKHR(threads);
+		parallel = true;
+	}
+	else if (HasExtension("GL_ARB_parallel_shader_compile"))
+	{
+		glMaxShaderCompilerThreadsARB(threads);
+		parallel = true;
+	}
+	else
+	{
+		parallel = false;
+	}
+}
+
+ShaderCompiler::~ShaderCompiler()
+{
+	for (auto& compile : pending)
+		delete compile.program;
+	pending.clear();
+}
+
+void ShaderCompiler::Compile(const std::vector<ShaderStageSource>& stages, Callback callback)
+{
+	// nothing here asks for a status so the driver is free to work on all of it in the background
+	auto program = new ShaderProgram();
+	for (const auto& stage : stages)
+		program->AttachShader(new Shader(stage.type, stage.source, false));
+
+	program->LinkAsync();
+	pending.push_back({ program, std::move(callback) });
+}
+
+std::future<ShaderProgram*> ShaderCompiler::Compile(const std::vector<ShaderStageSource>& stages)
+{
+	auto promise = std::make_shared<std::promise<ShaderProgram*>>();
+	auto future = promise->get_future();
+
+	Compile(stages, [promise](ShaderProgram* program) {
+		promise->set_value(program);
+	});
+	return future;
+}
+
+void ShaderCompiler::Deliver(Pending& compile)
+{
+	// the reflection waits for the link so it is only done now
+	char* log = nullptr;
+	if (!compile.program->FinishLink(&log, nullptr))
+	{
+		// the link log rarely says more than "attached shader failed", the compile logs do
+		for (auto shader : compile.program->GetAttachedShader())
+			shader->CheckStatus();
+
+		printf("SHADER LINK ERROR: %s", log);
+		delete[] log;
+	}
+
+	compile.callback(compile.program);
+}
+
+void ShaderCompiler::Update()
+{
+	// programs can finish out of order, a slow one does not hold back the rest
+	for (size_t i = 0; i < pending.size();)
+	{
+		if (parallel && !pending[i].program->IsLinkComplete())
+		{
+			i++;
+			continue;
+		}
+
+		auto compile = std::move(pending[i]);
+		pending.erase(pending.begin() + i);
+		Deliver(compile);
+	}
+}
+
+void ShaderCompiler::Finish()
+{
+	while (!pending.empty())
+	{
+		auto compile = std::move(pending.front());
+		pending.pop_front();
+		Deliver(compile);
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "Shader.h"
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <vector>
+
+class ShaderCompiler
+{
+public:
+	/**
+	* called with the program once the driver has finished compiling and linking it, the callback owns the program
+	* (check IsValid, the logs of failed stages are printed)
+	*/
+	using Callback = std::function<void(ShaderProgram* program)>;
+
+	/**
+	* creates the compiler and lets the driver compile on its own threads when it supports KHR_parallel_shader_compile
+	* (or ARB_parallel_shader_compile), without it every program is finished on the first Update instead
+	* @param threads maximum number of compiler threads, 0xFFFFFFFF lets the driver decide
+	*/
+	explicit ShaderCompiler(unsigned int threads = 0xFFFFFFFF);
+
+	/**
+	* destroys the programs still compiling, their callbacks are never called
+	*/
+	~ShaderCompiler();
+
+	ShaderCompiler(const ShaderCompiler&) = delete;
+	ShaderCompiler& operator=(const ShaderCompiler&) = delete;
+
+	/**
+	* issues the compiles of all the stages and the link of the program without waiting for any of them
+	* @param stages sources of the stages
+	* @param callback called from Update once the program is linked
+	*/
+	void Compile(const std::vector<ShaderStageSource>& stages, Callback callback);
+
+	/**
+	* same as Compile with a callback but returns a future
+	* @param stages sources of the stages
+	* @returns future that is ready after the Update that sees the program linked (do not wait on it
+	*	on the thread that calls Update)
+	*/
+	std::future<ShaderProgram*> Compile(const std::vector<ShaderStageSource>& stages);
+
+	/**
+	* checks the pending programs without blocking and delivers the ones the driver has finished.
+	* call once per frame on the render thread
+	*/
+	void Update();
+
+	/**
+	* blocks until every pending program is delivered, i.e at the end of a loading screen
+	*/
+	void Finish();
+
+	/**
+	* gets the number of programs still compiling
+	* @returns count
+	*/
+	size_t GetPendingCount() const { return pending.size(); }
+
+	/**
+	* checks if the driver compiles on its own threads
+	* @returns true with KHR_parallel_shader_compile or ARB_parallel_shader_compile
+	*/
+	bool IsParallel() const { return parallel; }
+
+private:
+	struct Pending
+	{
+		ShaderProgram* program;
+		Callback callback;
+	};
+
+	void Deliver(Pending& compile);
+
+	std::deque<Pending> pending;
+	bool parallel;
+};
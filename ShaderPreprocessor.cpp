@@ -0,0 +1,150 @@
+#include "ShaderPreprocessor.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+void ShaderPreprocessor::AddFile(const std::string& name, const std::string& source)
+{
+	auto found = fileIndices.find(name);
+	if (found != fileIndices.end())
+	{
+		files[found->second].source = source;
+		return;
+	}
+
+	fileIndices[name] = (int)files.size();
+	files.push_back({ name, source });
+}
+
+int ShaderPreprocessor::GetFileIndex(const std::string& name) const
+{
+	auto found = fileIndices.find(name);
+	return found != fileIndices.end() ? found->second : -1;
+}
+
+const std::string& ShaderPreprocessor::GetFileName(int index) const
+{
+	static const std::string none;
+	return index > 0 && index < (int)files.size() ? files[index].name : none;
+}
+
+std::string ShaderPreprocessor::InjectDefines(const std::string& source, const std::vector<std::string>& defines)
+{
+	if (defines.empty())
+		return source;
+
+	std::string lines;
+	for (const auto& define : defines)
+		lines += "#define " + define + "\n";
+
+	// #version has to stay the first thing in the source
+	auto version = source.find("#version");
+	if (version == std::string::npos)
+		return lines + source;
+
+	auto end = source.find('\n', version);
+	if (end == std::string::npos)
+		return source + "\n" + lines;
+
+	// the line after #version keeps its number in error logs
+	int line = 2;
+	for (size_t i = 0; i < version; i++)
+		line += source[i] == '\n';
+
+	return source.substr(0, end + 1) + lines + "#line " + std::to_string(line) + "\n" + source.substr(end + 1);
+}
+
+// gets the directive of a line, i.e "include" for #include "name", empty if the line is not a directive
+static std::string ParseDirective(const std::string& line, size_t& end)
+{
+	size_t i = line.find_first_not_of(" \t");
+	if (i == std::string::npos || line[i] != '#')
+		return {};
+
+	i = line.find_first_not_of(" \t", i + 1);
+	if (i == std::string::npos)
+		return {};
+
+	end = line.find_first_of(" \t\"<", i);
+	if (end == std::string::npos)
+		end = line.size();
+	return line.substr(i, end - i);
+}
+
+// gets the name of an #include "name" or #include <name> directive, empty if the line is not one
+static std::string ParseInclude(const std::string& line)
+{
+	size_t i = 0;
+	if (ParseDirective(line, i) != "include")
+		return {};
+
+	i = line.find_first_of("\"<", i);
+	if (i == std::string::npos)
+		return {};
+
+	auto end = line.find(line[i] == '"' ? '"' : '>', i + 1);
+	if (end == std::string::npos)
+		return {};
+
+	return line.substr(i + 1, end - i - 1);
+}
+
+bool ShaderPreprocessor::Expand(const std::string& source, int index, std::vector<bool>& included, std::string& output) const
+{
+	int lineNumber = 0;
+	size_t start = 0;
+	while (start < source.size())
+	{
+		auto end = source.find('\n', start);
+		if (end == std::string::npos)
+			end = source.size();
+
+		auto line = source.substr(start, end - start);
+		start = end + 1;
+		lineNumber++;
+
+		// #line directives already in the source (i.e the one after injected defines) move the count
+		size_t directiveEnd = 0;
+		if (ParseDirective(line, directiveEnd) == "line")
+			lineNumber = atoi(line.c_str() + directiveEnd) - 1;
+
+		auto name = ParseInclude(line);
+		if (name.empty())
+		{
+			output += line;
+			output += '\n';
+			continue;
+		}
+
+		int file = GetFileIndex(name);
+		if (file < 0)
+		{
+			printf("Shader Preprocessor Error : %s(%d) cannot include %s\n",
+				index == 0 ? "source" : files[index].name.c_str(), lineNumber, name.c_str());
+			return false;
+		}
+
+		// an empty line keeps the line numbers right
+		if (included[file])
+		{
+			output += '\n';
+			continue;
+		}
+		included[file] = true;
+
+		output += "#line 1 " + std::to_string(file) + "\n";
+		if (!Expand(files[file].source, file, included, output))
+			return false;
+		output += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(index) + "\n";
+	}
+
+	return true;
+}
+
+bool ShaderPreprocessor::Process(const std::string& source, const std::vector<std::string>& defines, std::string& output) const
+{
+	// defines go in first so the included files see them as well
+	std::vector<bool> included(files.size(), false);
+	output.clear();
+	return Expand(InjectDefines(source, defines), 0, included, output);
+}
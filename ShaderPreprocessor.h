@@ -0,0 +1,62 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ShaderPreprocessor
+{
+public:
+	/**
+	* adds a file that sources can #include "name", adding a name again replaces the file
+	* @param name name used in the #include directive
+	* @param source glsl source of the file
+	*/
+	void AddFile(const std::string& name, const std::string& source);
+
+	/**
+	* resolves the #include "name" directives of a source against the added files and inserts #define lines
+	* after its #version line. every file is included at most once so include guards are not needed. #line directives
+	* are emitted around included files, the source string number in error logs is 0 for the source itself and
+	* GetFileIndex(name) for files
+	* @param source glsl source
+	* @param defines names or "NAME VALUE" pairs
+	* @param output filled with the processed source
+	* @returns false if an included file does not exist (the error is printed)
+	*/
+	bool Process(const std::string& source, const std::vector<std::string>& defines, std::string& output) const;
+
+	/**
+	* gets the source string number used for a file in #line directives
+	* @param name name of the file
+	* @returns index (-1 if there is no such file)
+	*/
+	int GetFileIndex(const std::string& name) const;
+
+	/**
+	* gets the name of a file from the source string number of an error log
+	* @param index source string number
+	* @returns name (empty for 0, the processed source itself)
+	*/
+	const std::string& GetFileName(int index) const;
+
+	/**
+	* inserts #define lines after the #version line of a source (or at the start if it has none)
+	* @param source glsl source
+	* @param defines names or "NAME VALUE" pairs
+	* @returns source with the defines
+	*/
+	static std::string InjectDefines(const std::string& source, const std::vector<std::string>& defines);
+
+private:
+	struct File
+	{
+		std::string name;
+		std::string source;
+	};
+
+	bool Expand(const std::string& source, int index, std::vector<bool>& included, std::string& output) const;
+
+	// index 0 is reserved for the processed source
+	std::vector<File> files = { {} };
+	std::unordered_map<std::string, int> fileIndices;
+};
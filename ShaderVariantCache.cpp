@@ -0,0 +1,108 @@
+#include "ShaderVariantCache.h"
+
+#include <stdio.h>
+#include <algorithm>
+
+ShaderVariantCache::ShaderVariantCache(const ShaderPreprocessor& preprocessor, ProgramCache* binaryCache)
+	:preprocessor(preprocessor), binaryCache(binaryCache)
+{ }
+
+ShaderVariantCache::~ShaderVariantCache()
+{
+	for (auto& [key, program] : variants)
+		delete program;
+	variants.clear();
+}
+
+// sorted and without duplicates so every order of the same defines is the same variant
+static std::vector<std::string> SortDefines(std::vector<std::string> defines)
+{
+	std::sort(defines.begin(), defines.end());
+	defines.erase(std::unique(defines.begin(), defines.end()), defines.end());
+	return defines;
+}
+
+std::string ShaderVariantCache::VariantKey(const std::string& name, const std::vector<std::string>& sortedDefines)
+{
+	// a newline can be in neither a name nor a define
+	std::string key = name;
+	for (const auto& define : sortedDefines)
+		key += "\n" + define;
+	return key;
+}
+
+void ShaderVariantCache::DestroyVariants(const std::string& name)
+{
+	for (auto it = variants.begin(); it != variants.end();)
+	{
+		if (it->first.compare(0, name.size(), name) == 0 && (it->first.size() == name.size() || it->first[name.size()] == '\n'))
+		{
+			delete it->second;
+			it = variants.erase(it);
+		}
+		else
+		{
+			it++;
+		}
+	}
+}
+
+void ShaderVariantCache::Register(const std::string& name, const std::vector<ShaderStageSource>& stages)
+{
+	DestroyVariants(name);
+	shaders[name] = stages;
+}
+
+ShaderProgram* ShaderVariantCache::Get(const std::string& name, const std::vector<std::string>& defines)
+{
+	auto sorted = SortDefines(defines);
+	auto key = VariantKey(name, sorted);
+	auto found = variants.find(key);
+	if (found != variants.end())
+		return found->second;
+
+	auto shader = shaders.find(name);
+	if (shader == shaders.end())
+	{
+		printf("ShaderVariantCache: %s is not registered\n", name.c_str());
+		return nullptr;
+	}
+
+	// the sorted defines also keep the generated source (and the binary cache key) the same for every order
+	std::vector<ShaderStageSource> stages;
+	for (const auto& stage : shader->second)
+	{
+		std::string source;
+		if (!preprocessor.Process(stage.source, sorted, source))
+			return nullptr;
+		stages.push_back({ stage.type, std::move(source) });
+	}
+
+	ShaderProgram* program;
+	if (binaryCache != nullptr)
+	{
+		program = binaryCache->Load(stages);
+	}
+	else
+	{
+		program = new ShaderProgram();
+		for (const auto& stage : stages)
+			program->AttachShader(new Shader(stage.type, stage.source));
+
+		char* log = nullptr;
+		if (!program->Link(&log, nullptr))
+		{
+			printf("SHADER LINK ERROR: %s", log);
+			delete[] log;
+		}
+	}
+
+	variants[key] = program;
+	return program;
+}
+
+void ShaderVariantCache::Prewarm(const std::string& name, const std::vector<std::vector<std::string>>& defineSets)
+{
+	for (const auto& defines : defineSets)
+		Get(name, defines);
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "Shader.h"
+#include "ShaderPreprocessor.h"
+#include "ProgramCache.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ShaderVariantCache
+{
+public:
+	/**
+	* creates a cache of program permutations
+	* @param preprocessor preprocessor that resolves the #include directives of the sources (must outlive the cache)
+	* @param binaryCache optional on-disk binary cache the variants are loaded through (must outlive the cache)
+	*/
+	explicit ShaderVariantCache(const ShaderPreprocessor& preprocessor, ProgramCache* binaryCache = nullptr);
+
+	/**
+	* destroys all the compiled variants
+	*/
+	~ShaderVariantCache();
+
+	ShaderVariantCache(const ShaderVariantCache&) = delete;
+	ShaderVariantCache& operator=(const ShaderVariantCache&) = delete;
+
+	/**
+	* registers the sources of a shader, registering a name again replaces the sources and destroys its variants
+	* @param name name of the shader
+	* @param stages sources of the stages
+	*/
+	void Register(const std::string& name, const std::vector<ShaderStageSource>& stages);
+
+	/**
+	* gets the program of a permutation, compiling it the first time it is asked for. the order of the defines does
+	* not matter, {"A", "B"} and {"B", "A"} are the same variant
+	* @param name name of a registered shader
+	* @param defines names or "NAME VALUE" pairs
+	* @returns the program owned by the cache and shared by every caller (null if the shader is not registered or
+	*	the preprocessor failed), check IsValid
+	*/
+	ShaderProgram* Get(const std::string& name, const std::vector<std::string>& defines = {});
+
+	/**
+	* compiles a list of permutations up front, i.e behind a loading screen
+	* @param name name of a registered shader
+	* @param defineSets define set of every permutation
+	*/
+	void Prewarm(const std::string& name, const std::vector<std::vector<std::string>>& defineSets);
+
+	/**
+	* gets the number of compiled variants
+	* @returns count
+	*/
+	size_t GetVariantCount() const { return variants.size(); }
+
+private:
+	static std::string VariantKey(const std::string& name, const std::vector<std::string>& sortedDefines);
+	void DestroyVariants(const std::string& name);
+
+	const ShaderPreprocessor& preprocessor;
+	ProgramCache* binaryCache;
+
+	std::unordered_map<std::string, std::vector<ShaderStageSource>> shaders;
+	std::unordered_map<std::string, ShaderProgram*> variants;
+};
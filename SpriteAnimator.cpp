@@ -0,0 +1,279 @@
+#include "SpriteAnimator.h"
+#include "GL.h"
+
+#include <stdio.h>
+#include <algorithm>
+#include <glm/gtc/type_ptr.hpp>
+
+// handles of the uniforms set every draw
+static constexpr UniformHandle ProjectionUniform = "projection"_uniform;
+static constexpr UniformHandle TimeUniform = "time"_uniform;
+
+SpriteAnimator::SpriteAnimator(uint32_t maxSprites)
+	:maxSprites(maxSprites)
+{
+	static_assert(sizeof(GPUFrame) == 32 && sizeof(GPUClip) == 16 && sizeof(GPUSprite) == 48,
+		"sprite animation structs must match their std430 layout");
+
+	spriteBuffer = new Buffer(maxSprites * sizeof(GPUSprite), nullptr, true);
+	sprites.reserve(maxSprites);
+
+	std::string v_shader_source = R"(
+		#version 460
+		struct Frame
+		{
+			vec4 uv;
+			uvec2 texture_handle;
+			float end_time;
+			float padding;
+		};
+
+		struct Clip
+		{
+			uint first_frame;
+			uint frame_count;
+			float duration;
+			uint loop;
+		};
+
+		struct Sprite
+		{
+			vec2 position;
+			vec2 size;
+			vec4 color;
+			uint clip;
+			float start_time;
+			float rate;
+			float padding;
+		};
+
+		layout(std430, binding = 0) readonly buffer Frames { Frame frames[]; };
+		layout(std430, binding = 1) readonly buffer Clips { Clip clips[]; };
+		layout(std430, binding = 2) readonly buffer Sprites { Sprite sprites[]; };
+
+		uniform mat4 projection;
+		uniform float time;
+
+		out vec4 v_color;
+		out vec2 v_uv;
+		flat out uvec2 v_texture_handle;
+
+		const vec2 corners[6] = vec2[](
+			vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+			vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+		);
+
+		void main()
+		{
+			Sprite s = sprites[gl_InstanceID];
+			Clip c = clips[s.clip];
+
+			float t = (time - s.start_time) * s.rate;
+			if (c.loop != 0u)
+				t = mod(t, c.duration);
+			else
+				t = clamp(t, 0.0, c.duration);
+
+			// end times are cumulative from the start of the clip
+			uint frame = c.first_frame;
+			uint last = c.first_frame + c.frame_count - 1u;
+			while (frame < last && t >= frames[frame].end_time)
+				frame++;
+
+			Frame f = frames[frame];
+			vec2 corner = corners[gl_VertexID];
+
+			gl_Position = projection * vec4(s.position + corner * s.size, 0.0, 1.0);
+			v_color = s.color;
+			v_uv = mix(f.uv.xy, f.uv.zw, corner);
+			v_texture_handle = f.texture_handle;
+		}
+	)";
+
+	std::string f_shader_source = R"(
+		#version 460
+		#extension GL_ARB_bindless_texture : require
+
+		out vec4 frag_color;
+
+		in vec4 v_color;
+		in vec2 v_uv;
+		flat in uvec2 v_texture_handle;
+
+		void main()
+		{
+			if (v_texture_handle.x == 0 && v_texture_handle.y == 0)
+			{
+				frag_color = v_color;
+			}
+			else
+			{
+				frag_color = texture(sampler2D(v_texture_handle), v_uv) * v_color;
+			}
+		}
+	)";
+
+	auto v_shader = new Shader(ShaderType::Vertex, v_shader_source);
+	auto f_shader = new Shader(ShaderType::Fragment, f_shader_source);
+
+	shaderProgram = new ShaderProgram(v_shader, f_shader);
+
+	// sprites are expanded from gl_VertexID and gl_InstanceID so there are no attributes
+	vertexInput = new VertexInput();
+}
+
+SpriteAnimator::~SpriteAnimator()
+{
+	delete frameBuffer;
+	delete clipBuffer;
+	delete spriteBuffer;
+	delete vertexInput;
+	delete shaderProgram;
+}
+
+uint32_t SpriteAnimator::AddClip(const std::vector<AnimationFrame>& clipFrames, bool loop)
+{
+	// the shader indexes frames[first_frame + frame_count - 1] and takes mod(t, duration), an empty clip would read
+	// past the frame table and a zero duration gives NaN
+	float duration = 0.0f;
+	for (const auto& frame : clipFrames)
+	{
+		if (!(frame.duration >= 0.0f))
+		{
+			printf("SpriteAnimator: clip frames cannot have a negative duration\n");
+			return InvalidClip;
+		}
+		duration += frame.duration;
+	}
+
+	if (clipFrames.empty() || !(duration > 0.0f))
+	{
+		printf("SpriteAnimator: a clip needs at least one frame and a duration above zero\n");
+		return InvalidClip;
+	}
+
+	GPUClip clip = { (uint32_t)frames.size(), (uint32_t)clipFrames.size(), 0.0f, loop };
+
+	for (const auto& frame : clipFrames)
+	{
+		clip.duration += frame.duration;
+		frames.push_back({
+			{ frame.uvMin.x, frame.uvMin.y, frame.uvMax.x, frame.uvMax.y },
+			{ (uint32_t)(frame.textureHandle & 0xFFFFFFFF), (uint32_t)(frame.textureHandle >> 32) },
+			clip.duration,
+			0.0f
+		});
+	}
+
+	clips.push_back(clip);
+	clipsDirty = true;
+	return (uint32_t)clips.size() - 1;
+}
+
+uint32_t SpriteAnimator::AddClip(const TextureAtlas& atlas, const std::vector<int>& regions, float frameDuration, bool loop)
+{
+	std::vector<AnimationFrame> clipFrames;
+	clipFrames.reserve(regions.size());
+
+	for (auto id : regions)
+	{
+		const auto& region = atlas.GetRegion(id);
+		uint64_t handle = region.texture ? region.texture->GetHandle() : 0;
+		clipFrames.push_back({ region.uvMin, region.uvMax, handle, frameDuration });
+	}
+
+	return AddClip(clipFrames, loop);
+}
+
+void SpriteAnimator::MarkDirty(int sprite)
+{
+	if (dirtyBegin == dirtyEnd)
+	{
+		dirtyBegin = sprite;
+		dirtyEnd = sprite + 1;
+		return;
+	}
+
+	dirtyBegin = std::min(dirtyBegin, (size_t)sprite);
+	dirtyEnd = std::max(dirtyEnd, (size_t)sprite + 1);
+}
+
+int SpriteAnimator::AddSprite(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, uint32_t clip, float startTime, float rate)
+{
+	if (sprites.size() >= maxSprites || clip >= clips.size())
+		return -1;
+
+	sprites.push_back({ position, size, color, clip, startTime, rate, 0.0f });
+	int id = (int)sprites.size() - 1;
+	MarkDirty(id);
+	return id;
+}
+
+void SpriteAnimator::RemoveSprite(int sprite)
+{
+	if (sprite < 0 || sprite >= (int)sprites.size())
+		return;
+
+	sprites[sprite] = sprites.back();
+	sprites.pop_back();
+
+	if (sprite < (int)sprites.size())
+		MarkDirty(sprite);
+}
+
+void SpriteAnimator::SetPosition(int sprite, const glm::vec2& position)
+{
+	sprites[sprite].position = position;
+	MarkDirty(sprite);
+}
+
+void SpriteAnimator::Play(int sprite, uint32_t clip, float startTime, float rate)
+{
+	if (clip >= clips.size())
+	{
+		printf("SpriteAnimator: clip %u does not exist\n", clip);
+		return;
+	}
+
+	auto& s = sprites[sprite];
+	s.clip = clip;
+	s.startTime = startTime;
+	s.rate = rate;
+	MarkDirty(sprite);
+}
+
+void SpriteAnimator::Draw(const glm::mat4& projection, float time)
+{
+	if (clipsDirty)
+	{
+		// clips are added rarely so the tables are simply re-created
+		delete frameBuffer;
+		delete clipBuffer;
+		frameBuffer = new Buffer(frames.size() * sizeof(GPUFrame), frames.data(), false);
+		clipBuffer = new Buffer(clips.size() * sizeof(GPUClip), clips.data(), false);
+		clipsDirty = false;
+	}
+
+	dirtyEnd = std::min(dirtyEnd, sprites.size());
+	if (dirtyBegin < dirtyEnd)
+	{
+		spriteBuffer->SubData((dirtyEnd - dirtyBegin) * sizeof(GPUSprite), dirtyBegin * sizeof(GPUSprite), &sprites[dirtyBegin]);
+	}
+	dirtyBegin = dirtyEnd = 0;
+
+	if (sprites.empty() || clips.empty())
+		return;
+
+	frameBuffer->BindAsSSBO(0);
+	clipBuffer->BindAsSSBO(1);
+	spriteBuffer->BindAsSSBO(2);
+
+	vertexInput->Bind();
+	shaderProgram->Bind();
+
+	glm::mat4 proj = projection;
+	shaderProgram->UniformMat4(ProjectionUniform, glm::value_ptr(proj));
+	shaderProgram->UniformFloat(TimeUniform, time);
+
+	glDrawArraysInstanced(GL_TRIANGLES, 0, 6, (int)sprites.size());
+}
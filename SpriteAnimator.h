@@ -0,0 +1,147 @@
+#pragma once
+#include "Buffer.h"
+#include "Shader.h"
+#include "TextureAtlas.h"
+#include "VertexInput.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+struct AnimationFrame
+{
+	glm::vec2 uvMin;
+	glm::vec2 uvMax;
+	// bindless handle of the texture the frame is in (0 for no texture)
+	uint64_t textureHandle;
+	// how long the frame is shown in seconds
+	float duration;
+};
+
+class SpriteAnimator
+{
+public:
+	// returned by AddClip for clips that cannot be played
+	static constexpr uint32_t InvalidClip = 0xFFFFFFFF;
+
+	/**
+	* creates the sprite buffer, the frame of every sprite is picked in the vertex shader
+	* @param maxSprites maximum number of sprites
+	*/
+	explicit SpriteAnimator(uint32_t maxSprites);
+
+	/**
+	* destroys all the buffers
+	*/
+	~SpriteAnimator();
+
+	/**
+	* adds an animation clip, clips are uploaded to the gpu at the next Draw
+	* @param frames frames of the clip in order
+	* @param loop true to loop the clip otherwise it holds the last frame
+	* @returns id of the clip, InvalidClip if there are no frames or the clip has no duration
+	*/
+	uint32_t AddClip(const std::vector<AnimationFrame>& frames, bool loop = true);
+
+	/**
+	* adds an animation clip from atlas regions (the atlas must be built and bindless)
+	* @param atlas atlas containing the frames
+	* @param regions ids of the atlas regions in frame order
+	* @param frameDuration how long each frame is shown in seconds
+	* @param loop true to loop the clip otherwise it holds the last frame
+	* @returns id of the clip, InvalidClip if there are no regions or frameDuration is not positive
+	*/
+	uint32_t AddClip(const TextureAtlas& atlas, const std::vector<int>& regions, float frameDuration, bool loop = true);
+
+	/**
+	* adds a sprite, after this it costs nothing on the cpu unless it is changed
+	* @param position top left of the sprite
+	* @param size size of the sprite
+	* @param color color the frame is multiplied with
+	* @param clip clip to play
+	* @param startTime time (same clock as Draw) the clip starts at
+	* @param rate playback speed of the clip
+	* @returns id of the sprite or -1 if the animator is full or the clip does not exist
+	*/
+	int AddSprite(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, uint32_t clip, float startTime, float rate = 1.0f);
+
+	/**
+	* removes a sprite, the last sprite is moved into its place and takes over its id
+	* @param sprite id of the sprite to remove
+	*/
+	void RemoveSprite(int sprite);
+
+	/**
+	* moves a sprite
+	* @param sprite id of the sprite
+	* @param position new top left of the sprite
+	*/
+	void SetPosition(int sprite, const glm::vec2& position);
+
+	/**
+	* starts playing another clip on a sprite
+	* @param sprite id of the sprite
+	* @param clip clip to play
+	* @param startTime time (same clock as Draw) the clip starts at
+	* @param rate playback speed of the clip
+	*/
+	void Play(int sprite, uint32_t clip, float startTime, float rate = 1.0f);
+
+	/**
+	* uploads whatever changed and draws all the sprites with one instanced draw
+	* @param projection projection matrix to draw with
+	* @param time current time the frames are picked with
+	*/
+	void Draw(const glm::mat4& projection, float time);
+
+	/**
+	* gets the number of sprites
+	* @returns count
+	*/
+	uint32_t GetSpriteCount() const { return (uint32_t)sprites.size(); }
+
+private:
+#pragma pack(push, 1)
+	struct GPUFrame
+	{
+		glm::vec4 uv;
+		uint32_t texture[2];
+		float endTime;
+		float padding;
+	};
+
+	struct GPUClip
+	{
+		uint32_t firstFrame;
+		uint32_t frameCount;
+		float duration;
+		uint32_t loop;
+	};
+
+	struct GPUSprite
+	{
+		glm::vec2 position;
+		glm::vec2 size;
+		glm::vec4 color;
+		uint32_t clip;
+		float startTime;
+		float rate;
+		float padding;
+	};
+#pragma pack(pop)
+
+	void MarkDirty(int sprite);
+
+	uint32_t maxSprites;
+	std::vector<GPUFrame> frames;
+	std::vector<GPUClip> clips;
+	std::vector<GPUSprite> sprites;
+	bool clipsDirty = false;
+	size_t dirtyBegin = 0;
+	size_t dirtyEnd = 0;
+
+	Buffer* frameBuffer = nullptr;
+	Buffer* clipBuffer = nullptr;
+	Buffer* spriteBuffer;
+	VertexInput* vertexInput;
+	ShaderProgram* shaderProgram;
+};
@@ -3,6 +3,10 @@
 #include <stb_image.h>
 #include "GL.h"
 
+#include <algorithm>
+#include <bit>
+#include <utility>
+
 Texture2D::Texture2D()
 	:id(0), handle(0), width(0), height(0), format(Format::Unknown)
 { }
@@ -28,9 +32,10 @@ Texture2D::Texture2D(const char* path, bool flip, bool bindless)
 	stbi_image_free(data);
 }
 
-Texture2D::Texture2D(int width, int height, Format format, unsigned char* data, bool bindless)
+Texture2D::Texture2D(int width, int height, Format format, unsigned char* data, bool bindless, MemoryCategory category, int levels)
+	:id(0), handle(0), category(category)
 {
-	FromData(width, height, format, data, bindless);
+	FromData(width, height, format, data, bindless, levels);
 }
 
 Texture2D::~Texture2D()
@@ -39,9 +44,61 @@ Texture2D::~Texture2D()
 	if (handle != 0)
 		MakeTextureNonResident();
 
+	if (id != 0)
+		GPUMemory::Free(category, GetMemorySize());
 	glDeleteTextures(1, &id);
 }
 
+Texture2D::Texture2D(Texture2D&& other) noexcept
+	:id(std::exchange(other.id, 0)), handle(std::exchange(other.handle, 0)),
+	width(std::exchange(other.width, 0)), height(std::exchange(other.height, 0)), levels(std::exchange(other.levels, 1)),
+	format(std::exchange(other.format, Format::Unknown)), category(other.category)
+{ }
+
+Texture2D& Texture2D::operator=(Texture2D&& other) noexcept
+{
+	if (this != &other)
+	{
+		if (handle != 0)
+			MakeTextureNonResident();
+		if (id != 0)
+			GPUMemory::Free(category, GetMemorySize());
+		glDeleteTextures(1, &id);
+
+		id = std::exchange(other.id, 0);
+		handle = std::exchange(other.handle, 0);
+		width = std::exchange(other.width, 0);
+		height = std::exchange(other.height, 0);
+		levels = std::exchange(other.levels, 1);
+		format = std::exchange(other.format, Format::Unknown);
+		category = other.category;
+	}
+	return *this;
+}
+
+void Texture2D::SetCategory(MemoryCategory category)
+{
+	if (id != 0)
+	{
+		GPUMemory::Free(this->category, GetMemorySize());
+		GPUMemory::Allocate(category, GetMemorySize());
+	}
+	this->category = category;
+}
+
+size_t Texture2D::GetMemorySize() const
+{
+	size_t size = 0;
+	int w = width, h = height;
+	for (int level = 0; level < levels; level++)
+	{
+		size += (size_t)w * h * GetBytesPerPixel(format);
+		w = std::max(w / 2, 1);
+		h = std::max(h / 2, 1);
+	}
+	return size;
+}
+
 void Texture2D::GenerateMipmaps()
 {
 	glGenerateTextureMipmap(id);
@@ -64,27 +121,20 @@ void Texture2D::MakeTextureNonResident()
 	handle = 0;
 }
 
-void Texture2D::FromData(int width, int height, Format format, unsigned char* data, bool bindless)
+void Texture2D::FromData(int width, int height, Format format, unsigned char* data, bool bindless, int levels)
 {
 	this->width = width;
 	this->height = height;
 	this->format = format;
+	this->levels = levels > 0 ? levels : std::bit_width((unsigned int)std::max(std::max(width, height), 1));
 
 	glCreateTextures(GL_TEXTURE_2D, 1, &id);
-	glTextureStorage2D(id, 1, GLenum(format), width, height);
+	glTextureStorage2D(id, this->levels, GLenum(format), width, height);
+	GPUMemory::Allocate(category, GetMemorySize());
 
 	if (data != nullptr)
 	{
-		GLenum pixelFormat = 0;
-		switch (format)
-		{
-		case Format::R8: pixelFormat = GL_RED; break;
-		case Format::RG8: pixelFormat = GL_RG; break;
-		case Format::RGB8: pixelFormat = GL_RGB; break;
-		case Format::RGBA8: pixelFormat = GL_RGBA; break;
-		}
-
-		glTextureSubImage2D(id, 0, 0, 0, width, height, pixelFormat, GL_UNSIGNED_BYTE, data);
+		glTextureSubImage2D(id, 0, 0, 0, width, height, GetPixelFormat(format), GetPixelType(format), data);
 		glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 		glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 		glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -100,3 +150,46 @@ void Texture2D::FromData(int width, int height, Format format, unsigned char* da
 
 }
 
+unsigned int Texture2D::GetPixelFormat(Format format)
+{
+	switch (format)
+	{
+	case Format::R8: return GL_RED;
+	case Format::RG8: return GL_RG;
+	case Format::RGB8: return GL_RGB;
+	case Format::RGBA8: return GL_RGBA;
+	case Format::RGBA16F: return GL_RGBA;
+	case Format::R32I: return GL_RED_INTEGER;
+	case Format::R32UI: return GL_RED_INTEGER;
+	case Format::D24S8: return GL_DEPTH_STENCIL;
+	default: return 0;
+	}
+}
+
+unsigned int Texture2D::GetPixelType(Format format)
+{
+	switch (format)
+	{
+	case Format::RGBA16F: return GL_HALF_FLOAT;
+	case Format::R32I: return GL_INT;
+	case Format::R32UI: return GL_UNSIGNED_INT;
+	case Format::D24S8: return GL_UNSIGNED_INT_24_8;
+	default: return GL_UNSIGNED_BYTE;
+	}
+}
+
+int Texture2D::GetBytesPerPixel(Format format)
+{
+	switch (format)
+	{
+	case Format::R8: return 1;
+	case Format::RG8: return 2;
+	case Format::RGB8: return 3;
+	case Format::RGBA8: return 4;
+	case Format::RGBA16F: return 8;
+	case Format::R32I: return 4;
+	case Format::R32UI: return 4;
+	case Format::D24S8: return 4;
+	default: return 0;
+	}
+}
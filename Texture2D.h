@@ -1,4 +1,6 @@
 #pragma once
+#include "GPUMemory.h"
+
 #include <stdint.h>
 
 enum class Format
@@ -34,16 +36,30 @@ public:
 	* @param height height of the texture
 	* @param format pixel format of the texture
 	* @param data pointer to texture data (if null only the storage is allocated)
+	* @param bindless true to make the texture resident and get its bindless handle
+	* @param category memory accounting category the storage is counted in from the start (see GPUMemory)
+	* @param levels number of mip levels to allocate, 0 for a full chain down to 1x1 (fill them with GenerateMipmaps)
 	*/
-	explicit Texture2D(int width, int height, Format format, unsigned char* data = nullptr, bool bindless = false);
+	explicit Texture2D(int width, int height, Format format, unsigned char* data = nullptr, bool bindless = false,
+		MemoryCategory category = MemoryCategory::Texture, int levels = 1);
 
 	/**
 	* deletes the underlying OpenGL handle
 	*/
 	~Texture2D();
 
+	Texture2D(const Texture2D&) = delete;
+	Texture2D& operator=(const Texture2D&) = delete;
+
 	/**
-	* generate the mip maps
+	* takes over the OpenGL handle of another texture, the other one is left empty and can only be destroyed or assigned to
+	* @param other texture to move from
+	*/
+	Texture2D(Texture2D&& other) noexcept;
+	Texture2D& operator=(Texture2D&& other) noexcept;
+
+	/**
+	* generate the mip maps from level 0, only the levels allocated at creation are filled
 	*/
 	void GenerateMipmaps();
 	
@@ -83,6 +99,51 @@ public:
 
 	uint64_t GetHandle() const { return handle; }
 
+	/**
+	* moves the memory of the texture to another accounting category (see GPUMemory)
+	* @param category new category
+	*/
+	void SetCategory(MemoryCategory category);
+
+	/**
+	* gets the accounting category of the texture
+	* @returns category
+	*/
+	MemoryCategory GetCategory() const { return category; }
+
+	/**
+	* gets the size of the storage of the texture as accounted in GPUMemory
+	* @returns size in bytes
+	*/
+	size_t GetMemorySize() const;
+
+	/**
+	* gets the number of mip levels of the storage
+	* @returns levels
+	*/
+	int GetLevels() const { return levels; }
+
+	/**
+	* gets the client pixel format used to upload data of a format (e.g GL_RGBA for RGBA8)
+	* @param format format of the texture
+	* @returns pixel format
+	*/
+	static unsigned int GetPixelFormat(Format format);
+
+	/**
+	* gets the client pixel type used to upload data of a format (e.g GL_UNSIGNED_BYTE for RGBA8)
+	* @param format format of the texture
+	* @returns pixel type
+	*/
+	static unsigned int GetPixelType(Format format);
+
+	/**
+	* gets the size of one pixel of upload data of a format
+	* @param format format of the texture
+	* @returns size in bytes
+	*/
+	static int GetBytesPerPixel(Format format);
+
 private:
 	/**
 	* creates a texture from data
@@ -90,11 +151,14 @@ private:
 	* @param height height of the texture
 	* @param format pixel format of the texture
 	* @param data pointer to texture data (if null only the storage is allocated)
+	* @param levels number of mip levels, 0 for a full chain
 	*/
-	void FromData(int width, int height, Format format, unsigned char* data, bool bindless = false);
+	void FromData(int width, int height, Format format, unsigned char* data, bool bindless = false, int levels = 1);
 
 	unsigned int id;
 	uint64_t handle;
 	int width, height;
+	int levels = 1;
 	Format format;
+	MemoryCategory category = MemoryCategory::Texture;
 };
\ No newline at end of file
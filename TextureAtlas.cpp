@@ -0,0 +1,181 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <execution>
+#include <string.h>
+#include <stb_image.h>
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imgui/imstb_rectpack.h"
+
+TextureAtlas::TextureAtlas(int pageSize, int gutter, bool bindless)
+	:pageSize(pageSize), gutter(gutter), bindless(bindless)
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+	for (auto& image : pending)
+	{
+		if (image.fromFile)
+			stbi_image_free(image.pixels);
+		else
+			delete[] image.pixels;
+	}
+	pending.clear();
+
+	for (auto page : pages)
+		delete page;
+	pages.clear();
+}
+
+int TextureAtlas::Add(const std::string& path, bool flip)
+{
+	int id = (int)regions.size();
+	regions.push_back({});
+	pending.push_back({ id, path, flip, 0, 0, nullptr, true });
+	return id;
+}
+
+int TextureAtlas::Add(int width, int height, const unsigned char* pixels)
+{
+	int id = (int)regions.size();
+	regions.push_back({});
+
+	auto copy = new unsigned char[width * height * 4];
+	memcpy(copy, pixels, width * height * 4);
+	pending.push_back({ id, {}, false, width, height, copy, false });
+	return id;
+}
+
+void TextureAtlas::Blit(unsigned char* page, const PendingImage& image, int x, int y)
+{
+	// copies the image and extrudes its edge pixels into the gutter
+	const int paddedHeight = image.height + gutter * 2;
+
+	for (int row = 0; row < paddedHeight; row++)
+	{
+		int srcRow = std::clamp(row - gutter, 0, image.height - 1);
+		auto dst = page + ((y + row) * pageSize + x) * 4;
+		auto src = image.pixels + srcRow * image.width * 4;
+
+		for (int i = 0; i < gutter; i++)
+		{
+			memcpy(dst + i * 4, src, 4);
+			memcpy(dst + (gutter + image.width + i) * 4, src + (image.width - 1) * 4, 4);
+		}
+
+		memcpy(dst + gutter * 4, src, image.width * 4);
+	}
+}
+
+bool TextureAtlas::Build()
+{
+	if (pending.empty())
+		return true;
+
+	std::for_each(std::execution::par_unseq, pending.begin(), pending.end(),
+		[](PendingImage& image) {
+			if (!image.fromFile)
+				return;
+
+			int channels = 0;
+			stbi_set_flip_vertically_on_load_thread(image.flip);
+			image.pixels = stbi_load(image.path.c_str(), &image.width, &image.height, &channels, 4);
+		});
+
+	std::vector<stbrp_rect> rects;
+	for (int i = 0; i < (int)pending.size(); i++)
+	{
+		auto& image = pending[i];
+		if (image.pixels == nullptr)
+		{
+			printf("Failed to load texture %s\n", image.path.c_str());
+			continue;
+		}
+
+		stbrp_rect rect = {};
+		rect.id = i;
+		rect.w = image.width + gutter * 2;
+		rect.h = image.height + gutter * 2;
+		rects.push_back(rect);
+	}
+
+	// biggest first packs tighter
+	std::sort(rects.begin(), rects.end(), [](const stbrp_rect& a, const stbrp_rect& b) {
+		return a.h == b.h ? a.w > b.w : a.h > b.h;
+	});
+
+	bool packedAll = rects.size() == pending.size();
+	std::vector<stbrp_node> nodes(pageSize);
+	auto pixels = new unsigned char[pageSize * pageSize * 4];
+
+	while (!rects.empty())
+	{
+		stbrp_context context;
+		stbrp_init_target(&context, pageSize, pageSize, nodes.data(), (int)nodes.size());
+		stbrp_pack_rects(&context, rects.data(), (int)rects.size());
+
+		std::vector<stbrp_rect> remaining;
+		std::vector<stbrp_rect> packed;
+		for (auto& rect : rects)
+		{
+			if (rect.was_packed)
+				packed.push_back(rect);
+			else
+				remaining.push_back(rect);
+		}
+
+		// whatever did not fit in an empty page will never fit
+		if (packed.empty())
+		{
+			for (auto& rect : remaining)
+			{
+				const auto& image = pending[rect.id];
+				printf("Image %d (%dx%d) is too big for the atlas\n", image.id, image.width, image.height);
+			}
+			packedAll = false;
+			break;
+		}
+
+		memset(pixels, 0, pageSize * pageSize * 4);
+		for (auto& rect : packed)
+			Blit(pixels, pending[rect.id], rect.x, rect.y);
+
+		auto page = new Texture2D(pageSize, pageSize, Format::RGBA8, pixels, bindless, MemoryCategory::Texture, 0);
+		page->GenerateMipmaps();
+		pages.push_back(page);
+
+		for (auto& rect : packed)
+		{
+			const auto& image = pending[rect.id];
+			const float size = (float)pageSize;
+
+			glm::vec2 uvMin = { (rect.x + gutter) / size, (rect.y + gutter) / size };
+			glm::vec2 uvSize = { image.width / size, image.height / size };
+
+			auto& region = regions[image.id];
+			region.texture = page;
+			region.uvMin = uvMin;
+			region.uvMax = uvMin + uvSize;
+			// DrawQuad reads the rect as (v, u)
+			region.uv = { { uvMin.y, uvMin.x }, { uvSize.y, uvSize.x } };
+		}
+
+		rects = std::move(remaining);
+	}
+
+	delete[] pixels;
+
+	for (auto& image : pending)
+	{
+		if (image.fromFile)
+			stbi_image_free(image.pixels);
+		else
+			delete[] image.pixels;
+	}
+	pending.clear();
+
+	return packedAll;
+}
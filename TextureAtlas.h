@@ -0,0 +1,92 @@
+#pragma once
+#include "Batcher.h"
+#include "Texture2D.h"
+
+#include <string>
+#include <vector>
+
+struct AtlasRegion
+{
+	// page the image was packed into (null if it failed to load or pack)
+	Texture2D* texture;
+	// uv region in the layout Batcher::DrawQuad expects, can be used directly as Quad::uv
+	Rect uv;
+	// plain texture coordinates of the region corners
+	glm::vec2 uvMin;
+	glm::vec2 uvMax;
+};
+
+class TextureAtlas
+{
+public:
+	/**
+	* creates an empty atlas, nothing is allocated until Build
+	* @param pageSize width and height of every atlas page in pixels
+	* @param gutter pixels of edge extrusion around every image to avoid bleeding when filtering, pages have a full
+	*	mip chain and a gutter of g pixels keeps the first log2(g) + 1 levels free of bleeding
+	* @param bindless make the pages resident for bindless use
+	*/
+	explicit TextureAtlas(int pageSize = 2048, int gutter = 2, bool bindless = false);
+
+	/**
+	* destroys all the pages
+	*/
+	~TextureAtlas();
+
+	/**
+	* adds an image file to be packed by the next Build
+	* @param path path to the image file
+	* @param flip flip the image vertically
+	* @returns id of the region, valid after Build
+	*/
+	int Add(const std::string& path, bool flip = false);
+
+	/**
+	* adds already decoded pixels to be packed by the next Build (the pixels are copied)
+	* @param width width of the image
+	* @param height height of the image
+	* @param pixels RGBA8 pixels
+	* @returns id of the region, valid after Build
+	*/
+	int Add(int width, int height, const unsigned char* pixels);
+
+	/**
+	* decodes all the added files (on multiple threads), packs them into pages and uploads the pages.
+	* calling it again packs the images added since the last Build into new pages
+	* @returns true if every image was packed
+	*/
+	bool Build();
+
+	/**
+	* gets the region an image was packed into
+	* @param id id returned by Add
+	* @returns region
+	*/
+	const AtlasRegion& GetRegion(int id) const { return regions[id]; }
+
+	/**
+	* gets all the pages of the atlas
+	* @returns pages
+	*/
+	const std::vector<Texture2D*>& GetPages() const { return pages; }
+
+private:
+	struct PendingImage
+	{
+		int id;
+		std::string path;
+		bool flip;
+		int width, height;
+		unsigned char* pixels;
+		bool fromFile;
+	};
+
+	void Blit(unsigned char* page, const PendingImage& image, int x, int y);
+
+	int pageSize;
+	int gutter;
+	bool bindless;
+	std::vector<PendingImage> pending;
+	std::vector<AtlasRegion> regions;
+	std::vector<Texture2D*> pages;
+};
@@ -0,0 +1,241 @@
+#include "Tilemap.h"
+#include "GL.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/type_ptr.hpp>
+
+// handles of the uniforms set every draw
+static constexpr UniformHandle ProjectionUniform = "projection"_uniform;
+static constexpr UniformHandle ChunkOriginUniform = "chunk_origin"_uniform;
+
+Tilemap::Tilemap(int width, int height, const glm::vec2& tileSize, Texture2D* atlas, int atlasColumns, int atlasRows)
+	:width(width), height(height), tileSize(tileSize), atlas(atlas), atlasColumns(atlasColumns), atlasRows(atlasRows)
+{
+	chunksX = (width + ChunkSize - 1) / ChunkSize;
+	chunksY = (height + ChunkSize - 1) / ChunkSize;
+	chunks.resize(chunksX * chunksY);
+
+	std::string v_shader_source = R"(
+		#version 460
+		layout(std430, binding = 0) readonly buffer TileIndices
+		{
+			uint tiles[];
+		};
+
+		uniform mat4 projection;
+		uniform vec2 chunk_origin;
+		uniform vec2 tile_size;
+		uniform uvec2 atlas_tiles;
+		uniform int chunk_size;
+
+		out vec2 v_uv;
+
+		const vec2 corners[6] = vec2[](
+			vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+			vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+		);
+
+		void main()
+		{
+			int tile = gl_VertexID / 6;
+			vec2 corner = corners[gl_VertexID % 6];
+
+			// two 16 bit tiles are packed in every uint
+			uint packed_tiles = tiles[tile >> 1];
+			uint index = (tile & 1) == 0 ? (packed_tiles & 0xFFFFu) : (packed_tiles >> 16);
+
+			if (index == 0u)
+			{
+				// empty tile, move it outside the clip volume so it gets culled
+				gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+				v_uv = vec2(0.0);
+				return;
+			}
+
+			index -= 1u;
+			vec2 cell = vec2(tile % chunk_size, tile / chunk_size);
+			gl_Position = projection * vec4(chunk_origin + (cell + corner) * tile_size, 0.0, 1.0);
+
+			vec2 atlas_cell = vec2(index % atlas_tiles.x, index / atlas_tiles.x);
+			v_uv = (atlas_cell + corner) / vec2(atlas_tiles);
+		}
+	)";
+
+	std::string f_shader_source = R"(
+		#version 460
+
+		uniform sampler2D atlas;
+
+		out vec4 frag_color;
+
+		in vec2 v_uv;
+
+		void main()
+		{
+			frag_color = texture(atlas, v_uv);
+		}
+	)";
+
+	auto v_shader = new Shader(ShaderType::Vertex, v_shader_source);
+	auto f_shader = new Shader(ShaderType::Fragment, f_shader_source);
+
+	shaderProgram = new ShaderProgram(v_shader, f_shader);
+
+	// the quads are generated from gl_VertexID so there are no attributes
+	vertexInput = new VertexInput();
+
+	unsigned int atlasTiles[2] = { (unsigned int)atlasColumns, (unsigned int)atlasRows };
+	shaderProgram->UniformVec2("tile_size", glm::value_ptr(this->tileSize));
+	shaderProgram->UniformUVec2("atlas_tiles", atlasTiles);
+	shaderProgram->UniformInt("chunk_size", ChunkSize);
+	shaderProgram->UniformInt("atlas", 0);
+}
+
+Tilemap::~Tilemap()
+{
+	chunks.clear();
+
+	delete vertexInput;
+	delete shaderProgram;
+}
+
+Tilemap::Chunk& Tilemap::GetChunk(int x, int y, int& local)
+{
+	local = (y % ChunkSize) * ChunkSize + (x % ChunkSize);
+	return chunks[(y / ChunkSize) * chunksX + (x / ChunkSize)];
+}
+
+void Tilemap::Upload(Chunk& chunk)
+{
+	auto size = chunk.tiles.size() * sizeof(uint16_t);
+	if (chunk.buffer.GetID() == 0)
+		chunk.buffer = Buffer(size, chunk.tiles.data(), true);
+	else
+		chunk.buffer.SubData(size, 0, chunk.tiles.data());
+}
+
+void Tilemap::SetTile(int x, int y, uint16_t tile)
+{
+	if (x < 0 || y < 0 || x >= width || y >= height)
+		return;
+
+	int local;
+	auto& chunk = GetChunk(x, y, local);
+
+	if (chunk.tiles.empty())
+	{
+		if (tile == 0)
+			return;
+		chunk.tiles.resize(ChunkSize * ChunkSize, 0);
+	}
+
+	auto old = chunk.tiles[local];
+	if (old == tile)
+		return;
+
+	if (old == 0) chunk.used++;
+	if (tile == 0) chunk.used--;
+	chunk.tiles[local] = tile;
+
+	if (chunk.buffer.GetID() == 0)
+	{
+		Upload(chunk);
+		return;
+	}
+
+	// only the uint holding this tile and its neighbour is sent
+	int first = local & ~1;
+	chunk.buffer.SubData(sizeof(uint16_t) * 2, first * sizeof(uint16_t), &chunk.tiles[first]);
+}
+
+void Tilemap::SetTiles(const uint16_t* tiles)
+{
+	for (int cy = 0; cy < chunksY; cy++)
+	{
+		for (int cx = 0; cx < chunksX; cx++)
+		{
+			auto& chunk = chunks[cy * chunksX + cx];
+			chunk.used = 0;
+			chunk.tiles.assign(ChunkSize * ChunkSize, 0);
+
+			for (int y = 0; y < ChunkSize; y++)
+			{
+				int mapY = cy * ChunkSize + y;
+				if (mapY >= height)
+					break;
+
+				for (int x = 0; x < ChunkSize; x++)
+				{
+					int mapX = cx * ChunkSize + x;
+					if (mapX >= width)
+						break;
+
+					auto tile = tiles[mapY * width + mapX];
+					chunk.tiles[y * ChunkSize + x] = tile;
+					if (tile != 0) chunk.used++;
+				}
+			}
+
+			if (chunk.used == 0 && chunk.buffer.GetID() == 0)
+			{
+				chunk.tiles.clear();
+				continue;
+			}
+
+			Upload(chunk);
+		}
+	}
+}
+
+uint16_t Tilemap::GetTile(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= width || y >= height)
+		return 0;
+
+	const auto& chunk = chunks[(y / ChunkSize) * chunksX + (x / ChunkSize)];
+	if (chunk.tiles.empty())
+		return 0;
+
+	return chunk.tiles[(y % ChunkSize) * ChunkSize + (x % ChunkSize)];
+}
+
+void Tilemap::Draw(const glm::mat4& projection, const glm::vec2& viewMin, const glm::vec2& viewMax)
+{
+	const glm::vec2 chunkExtent = tileSize * (float)ChunkSize;
+
+	int firstX = (int)std::floor(viewMin.x / chunkExtent.x);
+	int firstY = (int)std::floor(viewMin.y / chunkExtent.y);
+	int lastX = (int)std::floor(viewMax.x / chunkExtent.x);
+	int lastY = (int)std::floor(viewMax.y / chunkExtent.y);
+
+	if (lastX < 0 || lastY < 0 || firstX >= chunksX || firstY >= chunksY)
+		return;
+
+	firstX = std::max(firstX, 0);
+	firstY = std::max(firstY, 0);
+	lastX = std::min(lastX, chunksX - 1);
+	lastY = std::min(lastY, chunksY - 1);
+
+	vertexInput->Bind();
+	shaderProgram->Bind();
+	atlas->Bind(0);
+
+	glm::mat4 proj = projection;
+	shaderProgram->UniformMat4(ProjectionUniform, glm::value_ptr(proj));
+
+	for (int cy = firstY; cy <= lastY; cy++)
+	{
+		for (int cx = firstX; cx <= lastX; cx++)
+		{
+			auto& chunk = chunks[cy * chunksX + cx];
+			if (chunk.used == 0)
+				continue;
+
+			glm::vec2 origin = { cx * chunkExtent.x, cy * chunkExtent.y };
+			shaderProgram->UniformVec2(ChunkOriginUniform, glm::value_ptr(origin));
+			chunk.buffer.BindAsSSBO(0);
+			glDrawArrays(GL_TRIANGLES, 0, ChunkSize * ChunkSize * 6);
+		}
+	}
+}
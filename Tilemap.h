@@ -0,0 +1,95 @@
+#pragma once
+#include "Buffer.h"
+#include "Shader.h"
+#include "Texture2D.h"
+#include "VertexInput.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+class Tilemap
+{
+public:
+	/**
+	* tiles per side of a chunk, each chunk keeps its tile indices in its own gpu buffer
+	*/
+	static constexpr int ChunkSize = 32;
+
+	/**
+	* creates an empty tilemap, chunk buffers are only created once a tile is set in them
+	* @param width width of the map in tiles
+	* @param height height of the map in tiles
+	* @param tileSize size of one tile in world units
+	* @param atlas texture containing all the tiles in a grid
+	* @param atlasColumns number of tile columns in the atlas
+	* @param atlasRows number of tile rows in the atlas
+	*/
+	explicit Tilemap(int width, int height, const glm::vec2& tileSize, Texture2D* atlas, int atlasColumns, int atlasRows);
+
+	/**
+	* destroys all the chunk buffers (the atlas is not owned by the tilemap)
+	*/
+	~Tilemap();
+
+	/**
+	* sets a single tile and updates only the affected chunk on the gpu
+	* @param x column of the tile
+	* @param y row of the tile
+	* @param tile 0 for an empty tile otherwise 1 + index of the tile in the atlas (row major)
+	*/
+	void SetTile(int x, int y, uint16_t tile);
+
+	/**
+	* sets all the tiles at once uploading every chunk a single time
+	* @param tiles width * height tiles in row major order (same encoding as SetTile)
+	*/
+	void SetTiles(const uint16_t* tiles);
+
+	/**
+	* gets a tile
+	* @param x column of the tile
+	* @param y row of the tile
+	* @returns tile (0 if empty or out of bounds)
+	*/
+	uint16_t GetTile(int x, int y) const;
+
+	/**
+	* draws the chunks overlapping the visible area, tile quads are generated in the vertex shader
+	* @param projection projection matrix to draw with
+	* @param viewMin top left of the visible area in world units
+	* @param viewMax bottom right of the visible area in world units
+	*/
+	void Draw(const glm::mat4& projection, const glm::vec2& viewMin, const glm::vec2& viewMax);
+
+	/**
+	* gets width of the map
+	* @returns width in tiles
+	*/
+	int GetWidth() const { return width; }
+
+	/**
+	* gets height of the map
+	* @returns height in tiles
+	*/
+	int GetHeight() const { return height; }
+
+private:
+	struct Chunk
+	{
+		Buffer buffer;
+		std::vector<uint16_t> tiles;
+		int used = 0;
+	};
+
+	Chunk& GetChunk(int x, int y, int& local);
+	void Upload(Chunk& chunk);
+
+	int width, height;
+	int chunksX, chunksY;
+	glm::vec2 tileSize;
+	Texture2D* atlas;
+	int atlasColumns, atlasRows;
+	std::vector<Chunk> chunks;
+	VertexInput* vertexInput;
+	ShaderProgram* shaderProgram;
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include "Buffer.h"
+#include "BlockLayout.h"
+#include "VertexInput.h"
+
+#include <span>
+#include <type_traits>
+
+template<typename T>
+class TypedBuffer
+{
+	static_assert(std::is_trivially_copyable_v<T>, "typed buffer elements have to be trivially copyable");
+
+public:
+	/**
+	* creates a buffer holding a copy of the elements
+	* @param data elements to upload
+	* @param storage storage flags of the buffer
+	*/
+	explicit TypedBuffer(std::span<const T> data, BufferStorage storage = BufferStorage::Dynamic)
+		:count(data.size()), buffer(data.size_bytes(), (void*)data.data(), storage, MemoryCategory::Vertex)
+	{ }
+
+	/**
+	* creates a buffer with room for count elements
+	* @param count number of elements
+	* @param storage storage flags of the buffer
+	*/
+	explicit TypedBuffer(size_t count, BufferStorage storage = BufferStorage::Dynamic)
+		:count(count), buffer(sizeof(T) * count, nullptr, storage, MemoryCategory::Vertex)
+	{ }
+
+	/**
+	* overwrites a range of elements (the buffer has to be Dynamic)
+	* @param data elements to upload
+	* @param first index of the first element to overwrite
+	*/
+	void Update(std::span<const T> data, size_t first = 0)
+	{
+		buffer.SubData(data.size_bytes(), sizeof(T) * first, (void*)data.data());
+	}
+
+	/**
+	* adds one attribute per member of T (described with JINGL_BLOCK_LAYOUT) at their offsets in T and
+	* attaches the buffer to the binding with a stride of sizeof(T). matrices and arrays take one location per
+	* column / element like in glsl
+	* @param input vertex input to set up
+	* @param binding binding point of the buffer
+	* @param firstLocation location of the first member
+	* @returns location after the last member
+	*/
+	int SetupVertexInput(VertexInput& input, int binding = 0, int firstLocation = 0)
+	{
+		int location = firstLocation;
+		for (const auto& member : T::BlockMembers())
+		{
+			size_t elements = member.count > 0 ? member.count : 1;
+			for (size_t e = 0; e < elements; e++)
+			{
+				for (size_t c = 0; c < member.columns; c++)
+				{
+					size_t offset = member.offset + e * member.elementStride + c * member.columnStride;
+					input.AddAttribute((int)member.components, member.componentType, location++, binding, (int)offset);
+				}
+			}
+		}
+
+		input.SetVertexBuffer(buffer, binding, (int)sizeof(T), 0);
+		return location;
+	}
+
+	/**
+	* gets the number of elements
+	* @returns count
+	*/
+	size_t GetCount() const { return count; }
+
+	/**
+	* gets the size of all the elements
+	* @returns size in bytes
+	*/
+	size_t GetSize() const { return sizeof(T) * count; }
+
+	/**
+	* gets the underlying buffer
+	* @returns buffer
+	*/
+	Buffer& GetBuffer() { return buffer; }
+
+private:
+	size_t count;
+	Buffer buffer;
+};
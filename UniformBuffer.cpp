@@ -0,0 +1,16 @@
+#include "UniformBuffer.h"
+#include "GL.h"
+
+size_t GetBufferOffsetAlignment(bool storage)
+{
+	static int uniformAlignment = 0;
+	static int storageAlignment = 0;
+
+	if (uniformAlignment == 0)
+	{
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+		glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+	}
+
+	return (size_t)(storage ? storageAlignment : uniformAlignment);
+}
@@ -0,0 +1,242 @@
+#pragma once
+#include "Buffer.h"
+#include "BlockLayout.h"
+#include "Shader.h"
+
+#include <stdio.h>
+#include <type_traits>
+
+/**
+* gets the offset alignment of ranges bound with glBindBufferRange
+* @param storage true for shader storage buffers, false for uniform buffers
+* @returns alignment in bytes
+*/
+size_t GetBufferOffsetAlignment(bool storage);
+
+/**
+* checks a struct described with JINGL_BLOCK_LAYOUT against a block reflected from a program, every member of
+* the block has to be at the offset of a member of the struct
+* @param block reflected block
+* @param array true if the block holds an array of T (T elements[])
+* @returns false if they do not match (the first mismatch is printed)
+*/
+template<typename T>
+bool MatchesBlock(const ShaderBlock& block, bool array)
+{
+	for (const auto& member : block.members)
+	{
+		if (array && member.topLevelArrayStride != 0 && (size_t)member.topLevelArrayStride != sizeof(T))
+		{
+			printf("Block %s: elements are %d bytes apart in the shader but %zu in the struct\n",
+				block.name.c_str(), member.topLevelArrayStride, sizeof(T));
+			return false;
+		}
+
+		bool found = false;
+		for (const auto& structMember : T::BlockMembers())
+			found |= structMember.offset == (size_t)member.offset;
+
+		if (!found)
+		{
+			printf("Block %s: no struct member at the offset %d of %s\n", block.name.c_str(), member.offset, member.name.c_str());
+			return false;
+		}
+	}
+
+	if (!array && sizeof(T) < (size_t)block.size)
+	{
+		printf("Block %s: %d bytes in the shader but the struct is %zu\n", block.name.c_str(), block.size, sizeof(T));
+		return false;
+	}
+
+	return true;
+}
+
+template<typename T>
+class UniformBuffer
+{
+	static_assert(std::is_trivially_copyable_v<T>, "uniform block structs have to be trivially copyable");
+	static_assert(CheckBlockLayout<T>(BlockLayout::Std140, false),
+		"the struct does not match the std140 layout, check the members listed in JINGL_BLOCK_LAYOUT");
+
+public:
+	/**
+	* creates a uniform buffer holding count blocks, each block starts at a multiple of the uniform buffer
+	* offset alignment so any of them can be bound on its own
+	* @param count number of blocks
+	*/
+	explicit UniformBuffer(size_t count = 1)
+		:stride(BlockAlignUp(sizeof(T), GetBufferOffsetAlignment(false))), count(count),
+		buffer(stride * count, nullptr, BufferStorage::Dynamic, MemoryCategory::Uniform)
+	{ }
+
+	/**
+	* uploads a whole block with a single SubData
+	* @param value value of the block
+	* @param index index of the block
+	*/
+	void Set(const T& value, size_t index = 0)
+	{
+		buffer.SubData(sizeof(T), index * stride, (void*)&value);
+	}
+
+	/**
+	* binds a block to a uniform buffer binding point with glBindBufferRange
+	* @param binding binding point
+	* @param index index of the block
+	*/
+	void Bind(int binding, size_t index = 0)
+	{
+		buffer.BindAsUBO(binding, index * stride, sizeof(T));
+	}
+
+	/**
+	* binds a block to the binding point a program reflects for a uniform block
+	* @param program program using the block
+	* @param blockName name of the uniform block
+	* @param index index of the block
+	* @returns false if the program has no such block
+	*/
+	bool Bind(const ShaderProgram& program, const char* blockName, size_t index = 0)
+	{
+		auto block = program.GetUniformBlock(blockName);
+		if (block == nullptr)
+			return false;
+
+		Bind(block->binding, index);
+		return true;
+	}
+
+	/**
+	* checks the struct against a uniform block of a program, i.e once after linking
+	* @param program program using the block
+	* @param blockName name of the uniform block
+	* @returns false if the program has no such block or it does not match (printed)
+	*/
+	bool Matches(const ShaderProgram& program, const char* blockName) const
+	{
+		auto block = program.GetUniformBlock(blockName);
+		return block != nullptr && MatchesBlock<T>(*block, false);
+	}
+
+	/**
+	* gets the number of blocks
+	* @returns count
+	*/
+	size_t GetCount() const { return count; }
+
+	/**
+	* gets the underlying buffer
+	* @returns buffer
+	*/
+	Buffer& GetBuffer() { return buffer; }
+
+private:
+	size_t stride;
+	size_t count;
+	Buffer buffer;
+};
+
+template<typename T>
+class StorageBuffer
+{
+	static_assert(std::is_trivially_copyable_v<T>, "storage block structs have to be trivially copyable");
+	static_assert(CheckBlockLayout<T>(BlockLayout::Std430, true),
+		"the struct does not match the std430 array layout, check the members listed in JINGL_BLOCK_LAYOUT and its size");
+
+public:
+	/**
+	* creates a shader storage buffer holding a tightly packed array of count elements (T elements[] in std430)
+	* @param count number of elements
+	* @param data initial elements (can be null)
+	*/
+	explicit StorageBuffer(size_t count, const T* data = nullptr)
+		:count(count), buffer(sizeof(T) * count, (void*)data, BufferStorage::Dynamic, MemoryCategory::Storage)
+	{ }
+
+	/**
+	* uploads one element
+	* @param value value of the element
+	* @param index index of the element
+	*/
+	void Set(const T& value, size_t index = 0)
+	{
+		buffer.SubData(sizeof(T), index * sizeof(T), (void*)&value);
+	}
+
+	/**
+	* uploads a range of elements with a single SubData
+	* @param values elements to upload
+	* @param valueCount number of elements
+	* @param first index of the first element to overwrite
+	*/
+	void Set(const T* values, size_t valueCount, size_t first = 0)
+	{
+		buffer.SubData(sizeof(T) * valueCount, sizeof(T) * first, (void*)values);
+	}
+
+	/**
+	* binds the whole array to a shader storage buffer binding point
+	* @param binding binding point
+	*/
+	void Bind(int binding)
+	{
+		buffer.BindAsSSBO(binding, 0, sizeof(T) * count);
+	}
+
+	/**
+	* binds a range of the array with glBindBufferRange, first * sizeof(T) has to be a multiple of
+	* GetBufferOffsetAlignment(true)
+	* @param binding binding point
+	* @param first index of the first element
+	* @param rangeCount number of elements
+	*/
+	void Bind(int binding, size_t first, size_t rangeCount)
+	{
+		buffer.BindAsSSBO(binding, first * sizeof(T), rangeCount * sizeof(T));
+	}
+
+	/**
+	* binds the whole array to the binding point a program reflects for a shader storage block
+	* @param program program using the block
+	* @param blockName name of the shader storage block
+	* @returns false if the program has no such block
+	*/
+	bool Bind(const ShaderProgram& program, const char* blockName)
+	{
+		auto block = program.GetStorageBlock(blockName);
+		if (block == nullptr)
+			return false;
+
+		Bind(block->binding);
+		return true;
+	}
+
+	/**
+	* checks the element struct against a shader storage block of a program, i.e once after linking
+	* @param program program using the block
+	* @param blockName name of the shader storage block
+	* @returns false if the program has no such block or it does not match (printed)
+	*/
+	bool Matches(const ShaderProgram& program, const char* blockName) const
+	{
+		auto block = program.GetStorageBlock(blockName);
+		return block != nullptr && MatchesBlock<T>(*block, true);
+	}
+
+	/**
+	* gets the number of elements
+	* @returns count
+	*/
+	size_t GetCount() const { return count; }
+
+	/**
+	* gets the underlying buffer
+	* @returns buffer
+	*/
+	Buffer& GetBuffer() { return buffer; }
+
+private:
+	size_t count;
+	Buffer buffer;
+};
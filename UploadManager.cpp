@@ -0,0 +1,177 @@
+#include "UploadManager.h"
+#include "GL.h"
+
+#include <string.h>
+#include <vector>
+
+// staging offsets are kept aligned so they are valid for every pixel type
+static constexpr size_t StagingAlignment = 16;
+
+UploadManager::UploadManager(size_t capacity, size_t frameBudget)
+	:capacity(capacity), frameBudget(frameBudget)
+{
+	staging = new Buffer(capacity, nullptr,
+		BufferStorage::MapWrite | BufferStorage::MapPersistent | BufferStorage::MapCoherent | BufferStorage::ClientStorage,
+		MemoryCategory::Staging);
+	mapped = (unsigned char*)staging->MapRange(0, capacity,
+		BufferMap::Write | BufferMap::Persistent | BufferMap::Coherent);
+}
+
+UploadManager::~UploadManager()
+{
+	for (auto& frame : inFlight)
+	{
+		frame.fence->Wait();
+		delete frame.fence;
+	}
+	inFlight.clear();
+
+	staging->Unmap();
+	delete staging;
+}
+
+UploadManager::Upload* UploadManager::Reserve(size_t size)
+{
+	size_t reserved = (size + StagingAlignment - 1) & ~(StagingAlignment - 1);
+	if (reserved > capacity)
+		return nullptr;
+
+	// an upload never wraps, the end of the ring is skipped instead
+	uint64_t start = head;
+	uint64_t position = head % capacity;
+	if (position + reserved > capacity)
+		start += capacity - position;
+
+	if (start + reserved - tail > capacity)
+		return nullptr;
+
+	head = start + reserved;
+	uploads.push_back({ nullptr, nullptr, 0, 0, 0, 0, 0, start, size, false });
+	return &uploads.back();
+}
+
+void UploadManager::Commit(Upload* upload)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	upload->committed = true;
+}
+
+bool UploadManager::UploadBuffer(Buffer* destination, size_t offset, const void* data, size_t size)
+{
+	if (size == 0)
+		return true;
+
+	Upload* upload;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		upload = Reserve(size);
+		if (upload == nullptr)
+			return false;
+
+		upload->buffer = destination;
+		upload->destinationOffset = offset;
+	}
+
+	// the slot is ours until it is committed so the copy happens outside the lock
+	memcpy(mapped + upload->ringOffset % capacity, data, size);
+	Commit(upload);
+	return true;
+}
+
+bool UploadManager::UploadTexture(Texture2D* destination, int x, int y, int width, int height, const void* pixels)
+{
+	size_t size = (size_t)width * height * Texture2D::GetBytesPerPixel(destination->GetFormat());
+	if (size == 0)
+		return true;
+
+	Upload* upload;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		upload = Reserve(size);
+		if (upload == nullptr)
+			return false;
+
+		upload->texture = destination;
+		upload->x = x;
+		upload->y = y;
+		upload->width = width;
+		upload->height = height;
+	}
+
+	memcpy(mapped + upload->ringOffset % capacity, pixels, size);
+	Commit(upload);
+	return true;
+}
+
+void UploadManager::Flush()
+{
+	// give back the staging space of every frame the gpu has finished
+	while (!inFlight.empty())
+	{
+		if (!inFlight.front().fence->IsSignaled())
+			break;
+
+		delete inFlight.front().fence;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tail = inFlight.front().ringEnd;
+		}
+		inFlight.pop_front();
+	}
+
+	// uploads are copied in reservation order so the recycled space is always a prefix of the ring
+	std::vector<Upload> ready;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		size_t bytes = 0;
+		while (!uploads.empty() && uploads.front().committed)
+		{
+			const auto& upload = uploads.front();
+			if (!ready.empty() && bytes + upload.size > frameBudget)
+				break;
+
+			bytes += upload.size;
+			ready.push_back(upload);
+			uploads.pop_front();
+		}
+	}
+
+	if (ready.empty())
+		return;
+
+	int unpackAlignment = 4;
+	glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging->GetID());
+
+	for (const auto& upload : ready)
+	{
+		size_t position = upload.ringOffset % capacity;
+		if (upload.buffer)
+		{
+			staging->CopyTo(*upload.buffer, position, upload.destinationOffset, upload.size);
+		}
+		else
+		{
+			auto format = upload.texture->GetFormat();
+			glTextureSubImage2D(upload.texture->GetID(), 0, upload.x, upload.y, upload.width, upload.height,
+				Texture2D::GetPixelFormat(format), Texture2D::GetPixelType(format), (const void*)position);
+		}
+	}
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+
+	const auto& last = ready.back();
+	uint64_t end = last.ringOffset + ((last.size + StagingAlignment - 1) & ~(StagingAlignment - 1));
+	inFlight.push_back({ new Fence(), end });
+}
+
+size_t UploadManager::GetPendingBytes()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	size_t bytes = 0;
+	for (const auto& upload : uploads)
+		bytes += upload.size;
+	return bytes;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "Buffer.h"
+#include "Texture2D.h"
+#include "Fence.h"
+
+#include <stdint.h>
+#include <deque>
+#include <mutex>
+
+class UploadManager
+{
+public:
+	/**
+	* creates the persistently mapped staging ring
+	* @param capacity size of the staging ring in bytes (the biggest single upload possible)
+	* @param frameBudget maximum number of bytes copied to their destination per Flush
+	*/
+	explicit UploadManager(size_t capacity, size_t frameBudget);
+
+	/**
+	* waits for the gpu to finish with the staging ring and destroys it
+	*/
+	~UploadManager();
+
+	/**
+	* copies data into the staging ring and queues a copy into a buffer. can be called from any thread
+	* @param destination buffer to copy into
+	* @param offset offset into the destination buffer
+	* @param data data to upload
+	* @param size size of the data in bytes
+	* @returns false if the ring has no room right now (try again after the next Flush)
+	*/
+	bool UploadBuffer(Buffer* destination, size_t offset, const void* data, size_t size);
+
+	/**
+	* copies pixels into the staging ring and queues a copy into a region of a texture. can be called from any thread
+	* @param destination texture to copy into
+	* @param x left of the region
+	* @param y top of the region
+	* @param width width of the region
+	* @param height height of the region
+	* @param pixels tightly packed pixels in the upload format of the texture format
+	* @returns false if the ring has no room right now (try again after the next Flush)
+	*/
+	bool UploadTexture(Texture2D* destination, int x, int y, int width, int height, const void* pixels);
+
+	/**
+	* recycles the staging space the gpu is done with and records the queued copies up to the frame budget.
+	* call once per frame on the render thread
+	*/
+	void Flush();
+
+	/**
+	* sets the maximum number of bytes copied per Flush (at least one upload is always copied)
+	* @param bytes budget
+	*/
+	void SetFrameBudget(size_t bytes) { frameBudget = bytes; }
+
+	/**
+	* gets the number of bytes waiting to be copied to their destination
+	* @returns bytes
+	*/
+	size_t GetPendingBytes();
+
+private:
+	struct Upload
+	{
+		Buffer* buffer;
+		Texture2D* texture;
+		size_t destinationOffset;
+		int x, y, width, height;
+		uint64_t ringOffset;
+		size_t size;
+		bool committed;
+	};
+
+	struct InFlight
+	{
+		Fence* fence;
+		uint64_t ringEnd;
+	};
+
+	Upload* Reserve(size_t size);
+	void Commit(Upload* upload);
+
+	Buffer* staging;
+	unsigned char* mapped;
+	size_t capacity;
+	size_t frameBudget;
+
+	// monotonic byte counters, the position in the ring is counter % capacity
+	uint64_t head = 0;
+	uint64_t tail = 0;
+
+	std::deque<Upload> uploads;
+	std::deque<InFlight> inFlight;
+	std::mutex mutex;
+};
@@ -1,6 +1,8 @@
 #include "VertexInput.h"
 #include "GL.h"
 
+#include <utility>
+
 VertexInput::VertexInput()
 	:offset(0), binding(0), index(0)
 {
@@ -62,6 +64,24 @@ VertexInput::~VertexInput()
 	glDeleteVertexArrays(1, &id);
 }
 
+VertexInput::VertexInput(VertexInput&& other) noexcept
+	:id(std::exchange(other.id, 0)), offset(std::exchange(other.offset, 0)),
+	binding(std::exchange(other.binding, 0)), index(std::exchange(other.index, 0))
+{ }
+
+VertexInput& VertexInput::operator=(VertexInput&& other) noexcept
+{
+	if (this != &other)
+	{
+		glDeleteVertexArrays(1, &id);
+		id = std::exchange(other.id, 0);
+		offset = std::exchange(other.offset, 0);
+		binding = std::exchange(other.binding, 0);
+		index = std::exchange(other.index, 0);
+	}
+	return *this;
+}
+
 void VertexInput::NextBinding()
 {
 	offset = 0;
@@ -125,10 +145,11 @@ void VertexInput::AddUVec4()
 }
 
 
-void VertexInput::AddAttribute(int size, int type, int index, int binding)
+void VertexInput::AddAttribute(int size, int type, int index, int binding, int relativeOffset)
 {
 	if (index == -1) index = this->index;
 	if (binding == -1) binding = this->binding;
+	if (relativeOffset != -1) offset = relativeOffset;
 
 	glVertexArrayAttribBinding(id, index, binding);
 	if (type == GL_DOUBLE)
@@ -177,6 +198,11 @@ void VertexInput::SetIndexBuffer(const Buffer& buffer)
 	glVertexArrayElementBuffer(id, buffer.GetID());
 }
 
+void VertexInput::SetBindingDivisor(int binding, int divisor)
+{
+	glVertexArrayBindingDivisor(id, binding, divisor);
+}
+
 void VertexInput::Bind()
 {
 	glBindVertexArray(id);
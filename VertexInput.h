@@ -21,6 +21,16 @@ public:
 	*/
 	~VertexInput();
 
+	VertexInput(const VertexInput&) = delete;
+	VertexInput& operator=(const VertexInput&) = delete;
+
+	/**
+	* takes over the OpenGL handle of another vertex input, the other one is left empty and can only be destroyed or assigned to
+	* @param other vertex input to move from
+	*/
+	VertexInput(VertexInput&& other) noexcept;
+	VertexInput& operator=(VertexInput&& other) noexcept;
+
 	/**
 	* increments the binding index so all the subsequent Add* call use the next binding point in the VAO
 	*/
@@ -85,8 +95,11 @@ public:
 	* adds an input attribute of size and type
 	* @param size of the input attribute (element count not size in bytes)
 	* @param type of the input attribute
+	* @param index attribute location, -1 for the next one
+	* @param binding binding point, -1 for the current one
+	* @param relativeOffset offset of the attribute in the vertex, -1 to place it right after the previous one
 	*/
-	void AddAttribute(int size, int type, int index = -1, int binding = -1);
+	void AddAttribute(int size, int type, int index = -1, int binding = -1, int relativeOffset = -1);
 
 	/**
 	* sets the vertex buffer to be used in the vertex stream for the shaders
@@ -103,6 +116,13 @@ public:
 	*/
 	void SetIndexBuffer(const Buffer& buffer);
 
+	/**
+	* sets how often the attributes of a binding point advance (for instanced rendering)
+	* @param binding binding point to modify
+	* @param divisor 0 to advance per vertex, n to advance once every n instances
+	*/
+	void SetBindingDivisor(int binding, int divisor);
+
 	/**
 	* binds the vertex input to used in subsequent draw calls
 	*/